@@ -0,0 +1,112 @@
+#include "iostream"
+#include <new>
+#include "../../src/commandline.hpp"
+
+/*
+ *  Parsing into caller storage must not touch the heap: every operator new while parsing is counted,
+ *  the first and every later parse after storageFor() have to stay at 0. Exits with 1 on the first failure.
+ */
+
+static long allocations = 0;
+
+void* operator new(size_t size){
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size){
+    return operator new(size);
+}
+void operator delete(void* p) noexcept{
+    free(p);
+}
+void operator delete[](void* p) noexcept{
+    free(p);
+}
+void operator delete(void* p, size_t) noexcept{
+    free(p);
+}
+void operator delete[](void* p, size_t) noexcept{
+    free(p);
+}
+
+
+int check(const char* what, long counted, int err){
+    std::cout << what << ": " << counted << " allocations, err " << err << std::endl;
+    return counted == 0 && err == ERR_NO_ERR ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* port = cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "The port to listen on"
+    )->addArgument(cli::NewParamter("number", "int"));
+    myCommandLine.addArgument(port);
+
+    cli::Argument* ids = cli::NewArgument(
+        cli::OPTION,
+        "i",
+        "ids",
+        false,
+        "The ids to serve, repeat it to append"
+    )->addArgument(cli::NewParamter("list", "int[]"));
+    myCommandLine.addArgument(ids);
+
+    cli::Argument* names = cli::NewArgument(
+        cli::OPTION,
+        "n",
+        "names",
+        false,
+        "The names to serve"
+    )->addArgument(cli::NewParamter("list", "string[]"));
+    myCommandLine.addArgument(names);
+
+    cli::Argument* verbose = cli::NewArgument(
+        cli::OPTION,
+        "v",
+        "verbose",
+        false,
+        "Talk more"
+    );
+    myCommandLine.addArgument(verbose);
+
+
+    const char* first[] = {"demo", "-p", "8080", "--ids", "1,2,3", "-n", "a,b,c", "--ids", "4,5", "-v"};
+    const char* later[] = {"demo", "--ids", "10,11,12,13,14,15,16,17", "-n", "alpha,beta", "-p", "1"};
+    int first_argc = sizeof(first)/sizeof(first[0]);
+    int later_argc = sizeof(later)/sizeof(later[0]);
+
+    int bytes = myCommandLine.storageFor(first_argc > later_argc ? first_argc : later_argc);
+    std::vector<char> storage(bytes);
+
+    int failed = 0;
+    long before = allocations;
+    int err = myCommandLine.parse(first_argc, (char**)first, storage.data(), bytes);
+    failed |= check("first parse", allocations-before, err);
+    if (myCommandLine.lists().count(ids->arguments[0]) != 5 || myCommandLine.lists().count(names->arguments[0]) != 3){
+        std::cout << "first parse: wrong list values" << std::endl;
+        failed = 1;
+    }
+
+    for (int k=0;k<3;k++){
+        before = allocations;
+        err = myCommandLine.parse(later_argc, (char**)later, storage.data(), bytes);
+        failed |= check("later parse", allocations-before, err);
+    }
+    if (myCommandLine.lists().count(ids->arguments[0]) != 8 || myCommandLine.lists().integers(ids->arguments[0])[7] != 17){
+        std::cout << "later parse: wrong list values" << std::endl;
+        failed = 1;
+    }
+
+    return failed;
+}
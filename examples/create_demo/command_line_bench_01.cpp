@@ -0,0 +1,84 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Flag matching on a schema of 1,000 options: the compact hot records (_match_flag) against a scan over the
+ *  Argument structs, the way the parser matched before the split. Both look up the same tokens, most of them
+ *  near the end of the schema. Prints the time per lookup and the bytes each scanned candidate pulls into cache.
+ *
+ *      ./command_line_bench_01 [rounds]
+ */
+
+#define BENCH_OPTIONS 1000
+#define BENCH_TOKENS 16
+
+//the pre split loop: every candidate is a cold Argument, its flag string is compared right away, the id of the match or -1
+int scan_arguments(const std::vector<cli::Argument*>& arguments, const char* tok){
+    for (int k=0;k<(int)arguments.size();k++){
+        cli::Argument* arg = arguments[k];
+        if (arg->arg_type&cli::OPTION && tok[1] == '-' && cli::_compare_cstring(tok+2, arg->long_flag))
+            return arg->id;
+        if (arg->arg_type&cli::OPTION && cli::_compare_cstring(tok+1, arg->short_flag))
+            return arg->id;
+    }
+    return -1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    int rounds = argc > 1 ? atoi(argv[1]) : 20000;
+    int verbosity = 0;
+    cli::argument_tree tree(&verbosity);
+
+    static char flags[BENCH_OPTIONS][2][16];
+    for (int k=0;k<BENCH_OPTIONS;k++){
+        snprintf(flags[k][0], 16, "s%d", k);
+        snprintf(flags[k][1], 16, "option-%d", k);
+        tree.addArgument(cli::NewArgument(
+            cli::OPTION,
+            flags[k][0],
+            flags[k][1],
+            false,
+            "One of a thousand options, each with a help text long enough to share cache lines with its flags"
+        ));
+    }
+    tree.finalize();
+
+    char tokens[BENCH_TOKENS][24];
+    for (int t=0;t<BENCH_TOKENS;t++)
+        snprintf(tokens[t], 24, t%2 ? "--option-%d" : "-s%d", BENCH_OPTIONS-1-t*37);
+
+    const std::vector<cli::Argument*>& arguments = tree.root->arguments;
+    uint64_t compares = 0;
+    long long found_hot = 0;
+    long long found_cold = 0;
+
+    uint64_t begin = cli::_now_ns();
+    for (int r=0;r<rounds;r++)
+        for (int t=0;t<BENCH_TOKENS;t++){
+            cli::_token_hash th(tokens[t]);
+            int h = cli::_match_flag(&tree, 0, tree.root_count, tokens[t], th, &compares);
+            found_hot += h < 0 ? -1 : tree.hot[h].id;
+        }
+    uint64_t hot_ns = cli::_now_ns()-begin;
+
+    begin = cli::_now_ns();
+    for (int r=0;r<rounds;r++)
+        for (int t=0;t<BENCH_TOKENS;t++)
+            found_cold += scan_arguments(arguments, tokens[t]);
+    uint64_t cold_ns = cli::_now_ns()-begin;
+
+    double lookups = (double)rounds*BENCH_TOKENS;
+    std::cout << BENCH_OPTIONS << " options, " << lookups << " lookups" << std::endl;
+    std::cout << "hot records      " << hot_ns/lookups << " ns/lookup, " << sizeof(cli::_hot_arg) << " bytes per candidate, "
+              << compares/lookups << " string compares per lookup" << std::endl;
+    std::cout << "Argument scan    " << cold_ns/lookups << " ns/lookup, " << sizeof(cli::Argument) << " bytes per candidate (plus the flag strings)" << std::endl;
+    if (found_hot != found_cold || found_hot < 0){
+        std::cout << "the two lookups disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  The string primitives picked at runtime (cli::_cli_str_ops(), AVX2 or SSE2 on x86) against the scalar loops,
+ *  on flags and values from 16 to 4096 characters: length, equality of two equal strings (the worst case, every
+ *  byte is compared) and a prefix compare over half of the string. Prints the time per call of both.
+ *
+ *      ./command_line_bench_02 [rounds]
+ */
+
+static volatile long long sink = 0;
+
+//ns per call of op over rounds calls
+template <typename F>
+double time_op(int rounds, F op){
+    long long sum = 0;
+    uint64_t begin = cli::_now_ns();
+    for (int r=0;r<rounds;r++)
+        sum += op();
+    uint64_t ns = cli::_now_ns()-begin;
+    sink += sum;
+    return (double)ns/rounds;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    int rounds = argc > 1 ? atoi(argv[1]) : 200000;
+    const cli::_str_ops& ops = cli::_cli_str_ops();
+    const char* picked = ops.length == cli::_strlen_scalar ? "scalar" : "vector";
+
+    const int lengths[] = {16, 64, 256, 4096};
+    std::cout << "length  op        scalar ns  " << picked << " ns" << std::endl;
+    for (int k=0;k<4;k++){
+        int l = lengths[k];
+        std::vector<char> a(l+1, 'x');
+        std::vector<char> b(l+1, 'x');
+        a[l] = b[l] = '\0';
+        const char* s1 = a.data();
+        const char* s2 = b.data();
+
+        double scalar = time_op(rounds, [s1](){ return cli::_strlen_scalar(s1); });
+        double vector = time_op(rounds, [s1, &ops](){ return ops.length(s1); });
+        printf("%6d  %-8s %10.1f %10.1f\n", l, "strlen", scalar, vector);
+
+        scalar = time_op(rounds, [s1, s2](){ return cli::_compare_scalar(s1, s2, INT_MAX); });
+        vector = time_op(rounds, [s1, s2, &ops](){ return ops.compare(s1, s2, INT_MAX); });
+        printf("%6d  %-8s %10.1f %10.1f\n", l, "equal", scalar, vector);
+
+        scalar = time_op(rounds, [s1, s2, l](){ return cli::_compare_scalar(s1, s2, l/2); });
+        vector = time_op(rounds, [s1, s2, l, &ops](){ return ops.compare(s1, s2, l/2); });
+        printf("%6d  %-8s %10.1f %10.1f\n", l, "prefix", scalar, vector);
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "iostream"
+#include "stdio.h"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Catalog round trip: writeCatalog() writes the built in texts, the test translates one help text and one error
+ *  message in a copy of it (new string appended, offset pointed at it) and loads that through setCatalog()/setLocale().
+ *  errorText() and the help have to use the translation, the untranslated entries the built in texts.
+ *  Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+std::vector<char> read_file(const char* path){
+    std::vector<char> data;
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr)
+        return data;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer+n);
+    fclose(file);
+    return data;
+}
+
+bool write_file(const char* path, const std::vector<char>& data){
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+        return false;
+    bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return fclose(file) == 0 && written;
+}
+
+//appends text and points offset table slot at it
+void translate(std::vector<char>* catalog, uint32_t slot, const char* text){
+    uint32_t offset = catalog->size();
+    memcpy(catalog->data()+16+4*slot, &offset, 4);
+    catalog->insert(catalog->end(), text, text+strlen(text)+1);
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* port = cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "Where incoming connections are accepted"
+    )->addArgument(cli::NewParamter("number", "int"));
+    myCommandLine.addArgument(port);
+
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "v",
+        "verbose",
+        false,
+        "Talk more"
+    ));
+
+
+    int failed = 0;
+    std::vector<int> matches;
+    const char* written = "command_line_catalog_test_01.en.cat";
+    failed |= check("catalog written", myCommandLine.writeCatalog(written) == ERR_NO_ERR);
+
+    std::vector<char> catalog = read_file(written);
+    uint32_t counts[2] = {0, 0};
+    if (catalog.size() >= 16)
+        memcpy(counts, catalog.data()+8, sizeof(counts));
+    failed |= check("header", catalog.size() >= 16 && memcmp(catalog.data(), CLI_CATALOG_MAGIC, 8) == 0 &&
+                             counts[1] == CLI_CATALOG_ERRORS && (int)counts[0] > port->id);
+    if (failed)
+        return failed;
+
+    //the written file loads as is and gives back the built in texts
+    myCommandLine.setCatalog("command_line_catalog_test_01.%s.cat");
+    myCommandLine.setLocale("en_US");
+    failed |= check("round trip error text", strcmp(myCommandLine.errorText(ERR_UNKOWN_INPUT), cli::ErrParse(ERR_UNKOWN_INPUT)) == 0);
+    failed |= check("round trip help text", myCommandLine.findHelp("incoming", &matches) == 1);
+
+    translate(&catalog, port->id, "Port, auf dem Verbindungen angenommen werden");
+    translate(&catalog, counts[0] + __builtin_ctz(ERR_UNKOWN_INPUT), "Unbekannte Eingabe");
+    failed |= check("translation written", write_file("command_line_catalog_test_01.de.cat", catalog));
+
+    //de_DE.UTF-8 falls back to the catalog of de
+    myCommandLine.setLocale("de_DE.UTF-8");
+    failed |= check("translated error text", strcmp(myCommandLine.errorText(ERR_UNKOWN_INPUT), "Unbekannte Eingabe") == 0);
+    failed |= check("untranslated error text", strcmp(myCommandLine.errorText(ERR_NOT_FOUND), cli::ErrParse(ERR_NOT_FOUND)) == 0);
+    failed |= check("help uses the translation", myCommandLine.findHelp("verbindungen", &matches) == 1);
+    failed |= check("built in help text replaced", myCommandLine.findHelp("incoming", &matches) == 0);
+    failed |= check("untranslated help text", myCommandLine.findHelp("talk", &matches) == 1);
+
+    //the C locale uses the built in texts
+    myCommandLine.setLocale("C");
+    failed |= check("C locale", strcmp(myCommandLine.errorText(ERR_UNKOWN_INPUT), cli::ErrParse(ERR_UNKOWN_INPUT)) == 0 &&
+                                myCommandLine.findHelp("incoming", &matches) == 1);
+
+    remove(written);
+    remove("command_line_catalog_test_01.de.cat");
+    return failed;
+}
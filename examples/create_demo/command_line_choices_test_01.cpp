@@ -0,0 +1,101 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Choices (Argument::addChoices): an accepted value comes out as its index through ParseResult::choice(), anything
+ *  else is ERR_WRONG_DATA. Checks a short list and one large enough for the perfect hash to spread over several
+ *  buckets. Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* format = cli::NewParamter("format", "string")->addChoices({"json", "yaml", "toml", "json"});
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "f",
+        "format",
+        false,
+        "The output format"
+    )->addArgument(format));
+
+    static char names[64][8];
+    cli::Argument* region = cli::NewParamter("region", "string");
+    for (int k=0;k<64;k++){
+        snprintf(names[k], sizeof(names[k]), "r%02d", k);
+        region->addChoices({names[k]});
+    }
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "r",
+        "region",
+        false,
+        "One of 64 regions"
+    )->addArgument(region));
+
+    cli::Argument* level = cli::NewParamter("level", "int")->addChoices({"1", "3", "5"});
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "l",
+        "level",
+        false,
+        "A compression level"
+    )->addArgument(level));
+
+
+    int failed = 0;
+    char text[256];
+
+    const char* yaml[] = {"demo", "-f", "yaml"};
+    int err = myCommandLine.parse(3, (char**)yaml);
+    failed |= check("yaml is a choice", err == ERR_NO_ERR);
+    failed |= check("yaml maps to 1", myCommandLine.parsed().choice(format) == 1);
+
+    const char* json[] = {"demo", "--format", "json"};
+    myCommandLine.parse(3, (char**)json);
+    failed |= check("a repeated choice keeps its first index", myCommandLine.parsed().choice(format) == 0);
+
+    const char* xml[] = {"demo", "-f", "xml"};
+    err = myCommandLine.parse(3, (char**)xml);
+    myCommandLine.describeError(text, sizeof(text));
+    failed |= check("xml is no choice", (err & ERR_WRONG_DATA) && strstr(text, "xml") != nullptr);
+
+    const char* prefix[] = {"demo", "-f", "jso"};
+    err = myCommandLine.parse(3, (char**)prefix);
+    failed |= check("a prefix of a choice is no choice", (err & ERR_WRONG_DATA) != 0);
+
+    const char* none[] = {"demo"};
+    myCommandLine.parse(1, (char**)none);
+    failed |= check("absent choice is -1", myCommandLine.parsed().choice(format) == -1);
+
+    int mapped = 0;
+    for (int k=0;k<64;k++){
+        const char* pick[] = {"demo", "-r", names[k]};
+        if (myCommandLine.parse(3, (char**)pick) == ERR_NO_ERR && myCommandLine.parsed().choice(region) == k)
+            mapped++;
+    }
+    failed |= check("all 64 regions map to their index", mapped == 64);
+
+    const char* unknown_region[] = {"demo", "-r", "r64"};
+    err = myCommandLine.parse(3, (char**)unknown_region);
+    failed |= check("r64 is no region", (err & ERR_WRONG_DATA) != 0);
+
+    const char* five[] = {"demo", "-l", "5"};
+    err = myCommandLine.parse(3, (char**)five);
+    failed |= check("numeric choice", err == ERR_NO_ERR && myCommandLine.parsed().choice(level) == 2 && myCommandLine.parsed().integer(level) == 5);
+
+    const char* four[] = {"demo", "-l", "4"};
+    err = myCommandLine.parse(3, (char**)four);
+    failed |= check("4 is no level", (err & ERR_WRONG_DATA) != 0);
+
+    return failed;
+}
@@ -0,0 +1,124 @@
+#include "iostream"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#define CLI_ENABLE_WATCHER
+#include "../../src/commandline.hpp"
+
+/*
+ *  CommandLine::merge(): defaults < config file < environment < argv, "flag" and "flag.param" keys, keys that name
+ *  no argument are listed in Config::unknown without failing the merge or a ConfigWatcher reload. Exits with 1 if
+ *  any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int write_file(const char* path, const char* text){
+    FILE* f = fopen(path, "wb");
+    if (f == nullptr)
+        return 0;
+    fputs(text, f);
+    fclose(f);
+    return 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+    const char* path = "command_line_config_test_01.conf";
+
+    cli::Argument* port = cli::NewParamter("number", "int")->setDefault("80");
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "The port to listen on"
+    )->addArgument(port));
+
+    cli::Argument* host = cli::NewParamter("name", "string")->setDefault("localhost");
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "H",
+        "host",
+        false,
+        "The host to bind"
+    )->setEnv("DEMO_CONFIG_HOST")->addArgument(host));
+
+    cli::Argument* ratio = cli::NewParamter("value", "double");
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "r",
+        "ratio",
+        false,
+        "A ratio"
+    )->addArgument(ratio));
+
+    cli::Argument* debug = cli::NewArgument(
+        cli::OPTION,
+        "d",
+        "debug",
+        false,
+        "Debug output"
+    );
+    myCommandLine.addArgument(debug);
+
+
+    int failed = 0;
+    unsetenv("DEMO_CONFIG_HOST");
+    const char* bare[] = {"demo"};
+    cli::Config config;
+
+    myCommandLine.parse(1, (char**)bare);
+    int err = myCommandLine.merge(&config);
+    failed |= check("merge without a file", err == ERR_NO_ERR);
+    failed |= check("port from its default", config.integer(port) == 80 && config.source(port) == CLI_SOURCE_DEFAULT);
+    failed |= check("ratio stays unset", config.value(ratio) == nullptr && config.source(ratio) == CLI_SOURCE_NONE);
+
+    if (!write_file(path, "# comment\nport.number = 8080\nhost = \"example.org\"\nratio = 0.25\ndebug = yes\ncolour = blue\n"))
+        return check("write the config file", false);
+    myCommandLine.setConfigFile(path);
+    err = myCommandLine.merge(&config);
+    failed |= check("merge with an unknown key", err == ERR_NO_ERR);
+    failed |= check("unknown key listed", config.unknown.size() == 1 && strcmp(config.unknown[0], "colour") == 0);
+    failed |= check("flag.param key", config.integer(port) == 8080 && config.source(port) == CLI_SOURCE_FILE);
+    failed |= check("quoted value", strcmp(config.value(host), "example.org") == 0);
+    failed |= check("double value", config.real(ratio) == 0.25);
+    failed |= check("flag switched on", config.integer(debug) == 1 && config.source(debug) == CLI_SOURCE_FILE);
+
+    setenv("DEMO_CONFIG_HOST", "env.example.org", 1);
+    const char* given[] = {"demo", "-p", "9090"};
+    myCommandLine.parse(3, (char**)given);
+    err = myCommandLine.merge(&config);
+    failed |= check("merge again into the same config", err == ERR_NO_ERR && config.unknown.size() == 1);
+    failed |= check("argv wins over the file", config.integer(port) == 9090 && config.source(port) == CLI_SOURCE_ARGV);
+    failed |= check("environment wins over the file", strcmp(config.value(host), "env.example.org") == 0 && config.source(host) == CLI_SOURCE_ENV);
+    unsetenv("DEMO_CONFIG_HOST");
+
+    write_file(path, "port = eighty\n");
+    myCommandLine.parse(1, (char**)bare);
+    err = myCommandLine.merge(&config);
+    failed |= check("invalid file value", (err & ERR_WRONG_DATA) != 0);
+
+    //a reload with an unknown key is still published
+    write_file(path, "port = 7070\ncolour = blue\n");
+    {
+        cli::ConfigWatcher watcher(&myCommandLine);
+        write_file(path, "port = 6060\ncolour = red\n");
+        err = watcher.reload();
+        cli::ConfigReader reader(watcher);
+        failed |= check("watcher reload with an unknown key", err == ERR_NO_ERR && watcher.reloads.load() == 1);
+        failed |= check("watcher publishes the new value", reader->integer(port) == 6060 && reader->unknown.size() == 1);
+    }
+
+    remove(path);
+    err = myCommandLine.merge(&config);
+    failed |= check("missing file", (err & ERR_CONFIG_FILE) != 0);
+
+    return failed;
+}
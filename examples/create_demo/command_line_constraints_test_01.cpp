@@ -0,0 +1,117 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Range, step and power of two constraints: negative values from argv, limits given in another type than the
+ *  parameter (they saturate to its range) and the errors describeError() reports. Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* offset = cli::NewParamter("offset", "int")->setRange(-5, 10);
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "n",
+        "offset",
+        false,
+        "An offset between -5 and 10"
+    )->addArgument(offset));
+
+    cli::Argument* ratio = cli::NewParamter("ratio", "double")->setRange(-1.0, 1.0)->setStep(0.1);
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "r",
+        "ratio",
+        false,
+        "A ratio in steps of 0.1"
+    )->addArgument(ratio));
+
+    cli::Argument* port = cli::NewParamter("port", "port")->setMin(-0.5);
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "A port, the minimum saturates to 0"
+    )->addArgument(port));
+
+    cli::Argument* count = cli::NewParamter("count", "uint64")->setStep(3);
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "c",
+        "count",
+        false,
+        "A multiple of 3"
+    )->addArgument(count));
+
+    cli::Argument* block = cli::NewParamter("block", "int")->setPowerOfTwo();
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "b",
+        "block",
+        false,
+        "A power of two"
+    )->addArgument(block));
+
+
+    int failed = 0;
+    char text[256];
+
+    const char* negative[] = {"demo", "-n", "-3", "-r", "-.5"};
+    int err = myCommandLine.parse(5, (char**)negative);
+    failed |= check("negative values are accepted", err == ERR_NO_ERR);
+    failed |= check("negative int decoded", myCommandLine.parsed().integer(offset) == -3);
+    failed |= check("negative double decoded", myCommandLine.parsed().real(ratio) == -0.5);
+
+    const char* below[] = {"demo", "-n", "-7"};
+    err = myCommandLine.parse(3, (char**)below);
+    myCommandLine.describeError(text, sizeof(text));
+    failed |= check("below the minimum", (err & ERR_OUT_OF_RANGE) && strstr(text, "below the minimum") != nullptr);
+
+    const char* above[] = {"demo", "--offset", "11"};
+    err = myCommandLine.parse(3, (char**)above);
+    myCommandLine.describeError(text, sizeof(text));
+    failed |= check("above the maximum", (err & ERR_OUT_OF_RANGE) && strstr(text, "above the maximum") != nullptr);
+
+    const char* on_step[] = {"demo", "-r", "0.3"};
+    err = myCommandLine.parse(3, (char**)on_step);
+    failed |= check("0.3 is a multiple of 0.1", err == ERR_NO_ERR);
+
+    const char* off_step[] = {"demo", "-r", "0.35"};
+    err = myCommandLine.parse(3, (char**)off_step);
+    myCommandLine.describeError(text, sizeof(text));
+    failed |= check("0.35 is not a multiple of 0.1", (err & ERR_OUT_OF_RANGE) && strstr(text, "multiple of the step") != nullptr);
+
+    const char* saturated[] = {"demo", "-p", "0"};
+    err = myCommandLine.parse(3, (char**)saturated);
+    failed |= check("minimum of -0.5 saturates to port 0", err == ERR_NO_ERR && myCommandLine.parsed().uinteger(port) == 0);
+
+    const char* largest[] = {"demo", "-c", "18446744073709551615"};
+    err = myCommandLine.parse(3, (char**)largest);
+    failed |= check("2^64-1 is a multiple of 3", err == ERR_NO_ERR);
+
+    const char* off_largest[] = {"demo", "-c", "18446744073709551614"};
+    err = myCommandLine.parse(3, (char**)off_largest);
+    failed |= check("2^64-2 is not a multiple of 3", (err & ERR_OUT_OF_RANGE) != 0);
+
+    const char* pow2[] = {"demo", "-b", "64"};
+    err = myCommandLine.parse(3, (char**)pow2);
+    failed |= check("64 is a power of two", err == ERR_NO_ERR);
+
+    const char* not_pow2[] = {"demo", "-b", "96"};
+    err = myCommandLine.parse(3, (char**)not_pow2);
+    myCommandLine.describeError(text, sizeof(text));
+    failed |= check("96 is not a power of two", (err & ERR_OUT_OF_RANGE) && strstr(text, "power of two") != nullptr);
+
+    return failed;
+}
@@ -0,0 +1,98 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Diagnostics: every problem of one parse is collected with its kind, argv index, byte offset and argument id,
+ *  and only formatted by describe(). Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* number = cli::NewParamter("number", "int")->setRange(1, 65535);
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "The port to listen on"
+    )->addArgument(number));
+
+    cli::Argument* ids = cli::NewParamter("list", "int[]")->setMax(10);
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "i",
+        "ids",
+        false,
+        "Up to ten ids"
+    )->addArgument(ids));
+
+    cli::Argument* input = cli::NewArgument(
+        cli::OPTION,
+        "I",
+        "input",
+        true,
+        "The file to read"
+    )->addArgument(cli::NewParamter("path", "string"));
+    myCommandLine.addArgument(input);
+
+
+    int failed = 0;
+    char text[256];
+    const cli::ParseResult& r = myCommandLine.parsed();
+
+    const char* fine[] = {"demo", "-I", "in.txt", "-p", "80"};
+    int err = myCommandLine.parse(5, (char**)fine);
+    failed |= check("no diagnostics on success", err == ERR_NO_ERR && r.diagnostic_count == 0);
+    failed |= check("describe without a diagnostic", myCommandLine.describeError(text, sizeof(text)) == 0 && text[0] == '\0');
+
+    const char* broken[] = {"demo", "--prot", "-p", "70000", "--ids", "1,2,99", "-p", "http"};
+    err = myCommandLine.parse(8, (char**)broken);
+    failed |= check("all kinds in the error bits", (err & ERR_UNKOWN_INPUT) && (err & ERR_OUT_OF_RANGE) && (err & ERR_WRONG_DATA) && (err & ERR_REQ_ARG_NOT_FOUND));
+    failed |= check("one diagnostic per problem", r.diagnostic_count == 5);
+
+    const cli::Diagnostic& unknown = r.diagnostics[0];
+    failed |= check("unknown token", unknown.kind == ERR_UNKOWN_INPUT && unknown.argv_index == 1 && unknown.id == -1 && strcmp(unknown.text, "--prot") == 0);
+    myCommandLine.describe(0, text, sizeof(text));
+    failed |= check("unknown token text", strcmp(text, "argv[1]: unknown argument \"--prot\"") == 0);
+
+    const cli::Diagnostic& range = r.diagnostics[1];
+    failed |= check("out of range", range.kind == ERR_OUT_OF_RANGE && range.argv_index == 3 && range.id == number->id && range.detail == CLI_CHECK_MAX);
+    myCommandLine.describe(1, text, sizeof(text));
+    failed |= check("out of range text", strcmp(text, "argv[3]: --port <number>: 70000 is above the maximum 65535") == 0);
+
+    const cli::Diagnostic& element = r.diagnostics[2];
+    failed |= check("list element offset", element.kind == ERR_OUT_OF_RANGE && element.argv_index == 5 && element.offset == 4 && element.id == ids->id);
+    myCommandLine.describe(2, text, sizeof(text));
+    failed |= check("list element text", strncmp(text, "argv[5]+4: ", 11) == 0);
+
+    const cli::Diagnostic& wrong = r.diagnostics[3];
+    failed |= check("wrong data", wrong.kind == ERR_WRONG_DATA && wrong.argv_index == 7 && wrong.id == number->id);
+
+    const cli::Diagnostic& missing = r.diagnostics[4];
+    failed |= check("missing argument", missing.kind == ERR_REQ_ARG_NOT_FOUND && missing.argv_index == -1 && missing.id == input->id);
+    myCommandLine.describe(4, text, sizeof(text));
+    failed |= check("missing argument text", strcmp(text, "--input is required") == 0);
+
+    int full = myCommandLine.describe(1, text, 12);
+    failed |= check("truncated like snprintf", full > 11 && strlen(text) == 11);
+    failed |= check("index past the end", myCommandLine.describe(5, text, sizeof(text)) == 0);
+
+    const char* many[] = {"demo", "-I", "in.txt", "-a", "-b", "-c", "-d", "-e", "-f", "-g", "-h1", "-j", "-k", "-l", "-m", "-n", "-o",
+                          "-q", "-r", "-s", "-t"};
+    int many_argc = sizeof(many)/sizeof(many[0]);
+    err = myCommandLine.parse(many_argc, (char**)many);
+    failed |= check("count goes past the array", r.diagnostic_count == many_argc-3 && r.diagnostic_count > CLI_MAX_DIAGNOSTICS);
+    failed |= check("the first ones are kept", r.diagnostics[CLI_MAX_DIAGNOSTICS-1].argv_index == CLI_MAX_DIAGNOSTICS+2);
+
+    return failed;
+}
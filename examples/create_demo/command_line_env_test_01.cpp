@@ -0,0 +1,74 @@
+#include "iostream"
+#include "stdlib.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Environment fallbacks (Argument::setEnv): used only when the flag is absent from argv, checked like an argv
+ *  value, and a plain flag reads its variable as a boolean. Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* number = cli::NewParamter("number", "int")->setRange(1, 65535);
+    cli::Argument* port = cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "The port to listen on, DEMO_PORT when not given"
+    )->setEnv("DEMO_PORT")->addArgument(number);
+    myCommandLine.addArgument(port);
+
+    cli::Argument* debug = cli::NewArgument(
+        cli::OPTION,
+        "d",
+        "debug",
+        false,
+        "Debug output, DEMO_DEBUG when not given"
+    )->setEnv("DEMO_DEBUG");
+    myCommandLine.addArgument(debug);
+
+
+    int failed = 0;
+    const char* bare[] = {"demo"};
+    const char* given[] = {"demo", "-p", "80"};
+
+    setenv("DEMO_PORT", "9000", 1);
+    setenv("DEMO_DEBUG", "yes", 1);
+    int err = myCommandLine.parse(1, (char**)bare);
+    failed |= check("parse with the environment", err == ERR_NO_ERR);
+    failed |= check("port from the environment", myCommandLine.parsed().integer(number) == 9000);
+    failed |= check("port source is the environment", myCommandLine.parsed().source(port) == CLI_SOURCE_ENV);
+    failed |= check("debug switched on by yes", myCommandLine.parsed().has(debug) && myCommandLine.parsed().source(debug) == CLI_SOURCE_ENV);
+
+    err = myCommandLine.parse(3, (char**)given);
+    failed |= check("argv wins over the environment", err == ERR_NO_ERR && myCommandLine.parsed().integer(number) == 80);
+    failed |= check("port source is argv", myCommandLine.parsed().source(port) == CLI_SOURCE_ARGV);
+
+    setenv("DEMO_DEBUG", "off", 1);
+    err = myCommandLine.parse(1, (char**)bare);
+    failed |= check("debug left off by off", err == ERR_NO_ERR && !myCommandLine.parsed().has(debug));
+
+    setenv("DEMO_PORT", "70000", 1);
+    err = myCommandLine.parse(1, (char**)bare);
+    failed |= check("environment value checked against the range", (err & ERR_OUT_OF_RANGE) != 0);
+
+    setenv("DEMO_PORT", "eighty", 1);
+    err = myCommandLine.parse(1, (char**)bare);
+    failed |= check("invalid environment value", (err & ERR_WRONG_DATA) != 0);
+
+    unsetenv("DEMO_PORT");
+    err = myCommandLine.parse(1, (char**)bare);
+    failed |= check("unset variable leaves the port absent", err == ERR_NO_ERR && !myCommandLine.parsed().has(port));
+
+    return failed;
+}
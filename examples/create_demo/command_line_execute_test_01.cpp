@@ -0,0 +1,74 @@
+#include "iostream"
+#include "../../src/commandline.hpp"
+
+/*
+ *  execute() runs the callbacks of the parsed options and wildcards (also combined, WILDCARD | OPTION) and the
+ *  methods in command line order. Exits with 1 if any check fails.
+ */
+
+static int wildcard_calls = 0;
+static int option_calls = 0;
+static int method_argc = -1;
+static std::string method_value;
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* wildcard = cli::NewArgument(
+        cli::WILDCARD | cli::OPTION,
+        "w",
+        "wild",
+        false,
+        "A wildcard that is an option as well"
+    )->setCallback([](){ wildcard_calls++; return ERR_NO_ERR; });
+    myCommandLine.addArgument(wildcard);
+
+    cli::Argument* option = cli::NewArgument(
+        cli::OPTION,
+        "o",
+        "opt",
+        false,
+        "A plain option"
+    )->setCallback([](){ option_calls++; return ERR_NO_ERR; });
+    myCommandLine.addArgument(option);
+
+    cli::Argument* run = cli::NewArgument(
+        cli::METHOD,
+        "r",
+        "run",
+        false,
+        "A method with one parameter"
+    )->addArgument(cli::NewParamter("name", "string"));
+    run->setMethod([](int argc, char** argv, cli::Options* options){
+        method_argc = argc;
+        method_value = argc > 0 ? argv[0] : "";
+        return options != nullptr ? ERR_NO_ERR : ERR_NOT_FOUND;
+    });
+    myCommandLine.addArgument(run);
+
+
+    const char* args[] = {"demo", "-w", "run", "job", "-o"};
+    int failed = 0;
+    int err = myCommandLine.parse(5, (char**)args);
+    failed |= check("parse", err == ERR_NO_ERR);
+    err = myCommandLine.execute();
+    failed |= check("execute", err == ERR_NO_ERR);
+    failed |= check("wildcard | option callback ran once", wildcard_calls == 1);
+    failed |= check("option callback ran once", option_calls == 1);
+    failed |= check("method got its parameter", method_argc == 1 && method_value == "job");
+
+    const char* none[] = {"demo", "-o"};
+    myCommandLine.parse(2, (char**)none);
+    myCommandLine.execute();
+    failed |= check("absent arguments do not run", wildcard_calls == 1 && option_calls == 2 && method_argc == 1);
+
+    return failed;
+}
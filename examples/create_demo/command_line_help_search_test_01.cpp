@@ -0,0 +1,77 @@
+#include "iostream"
+#include "../../src/commandline.hpp"
+
+/*
+ *  --help=<pattern>: findHelp() searches flags, parameters, help messages and choices case insensitively through the
+ *  trigram index, which is rebuilt after a schema change. Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "p",
+        "port",
+        false,
+        "Where incoming connections are accepted"
+    )->addArgument(cli::NewParamter("number", "int")));
+
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "f",
+        "format",
+        false,
+        "How results are printed"
+    )->addArgument(cli::NewParamter("format", "string")->addChoices({"json", "yaml"})));
+
+    cli::Argument* serve = cli::NewArgument(
+        cli::METHOD,
+        "s",
+        "serve",
+        false,
+        "Run the server"
+    );
+    serve->addArgument(cli::NewArgument(
+        cli::OPTION,
+        "t",
+        "tls",
+        false,
+        "Encrypt every Connection"
+    ));
+    myCommandLine.addArgument(serve);
+
+
+    int failed = 0;
+    std::vector<int> matches;
+
+    failed |= check("flag name", myCommandLine.findHelp("port", &matches) == 1 && matches[0] == 0);
+    failed |= check("case insensitive", myCommandLine.findHelp("PoRt", &matches) == 1 && matches[0] == 0);
+    failed |= check("help message", myCommandLine.findHelp("printed", &matches) == 1 && matches[0] == 1);
+    failed |= check("choice", myCommandLine.findHelp("yaml", &matches) == 1 && matches[0] == 1);
+    failed |= check("parameter name", myCommandLine.findHelp("number", &matches) == 1);
+    failed |= check("nested flag", myCommandLine.findHelp("encrypt", &matches) == 1);
+    failed |= check("several rows", myCommandLine.findHelp("connection", &matches) == 2 && matches[0] < matches[1]);
+    failed |= check("shorter than a trigram", myCommandLine.findHelp("js", &matches) == 1 && matches[0] == 1);
+    failed |= check("nothing found", myCommandLine.findHelp("verbose", &matches) == 0);
+    failed |= check("trigrams present, text not", myCommandLine.findHelp("portjson", &matches) == 0);
+
+    myCommandLine.addArgument(cli::NewArgument(
+        cli::OPTION,
+        "v",
+        "verbose",
+        false,
+        "Talk more"
+    ));
+    failed |= check("rebuilt after a schema change", myCommandLine.findHelp("verbose", &matches) == 1);
+
+    return failed;
+}
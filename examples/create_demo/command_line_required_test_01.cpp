@@ -0,0 +1,79 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Required arguments: a required flag, a required parameter (only when its flag is given) and a required
+ *  positional, all listed by ParseResult::missing(). A positional whose value is rejected stays missing.
+ *  Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* input = cli::NewArgument(
+        cli::OPTION,
+        "i",
+        "input",
+        true,
+        "The file to read"
+    )->addArgument(cli::NewParamter("path", "string"));
+    myCommandLine.addArgument(input);
+
+    cli::Argument* level = cli::NewParamter("number", "int")->setRequired(true);
+    cli::Argument* compress = cli::NewArgument(
+        cli::OPTION,
+        "c",
+        "compress",
+        false,
+        "Compress with a level"
+    )->addArgument(level);
+    myCommandLine.addArgument(compress);
+
+    cli::Argument* count = cli::NewParamter("count", "int")->setRange(1, 10)->setRequired(true);
+    myCommandLine.addArgument(count);
+
+
+    int failed = 0;
+    int ids[8];
+    const cli::ParseResult& r = myCommandLine.parsed();
+
+    const char* fine[] = {"demo", "-i", "in.txt", "3"};
+    int err = myCommandLine.parse(4, (char**)fine);
+    failed |= check("everything required is given", err == ERR_NO_ERR && r.missing(ids, 8) == 0);
+    failed |= check("positional decoded", r.has(count) && r.integer(count) == 3);
+
+    const char* no_input[] = {"demo", "5"};
+    err = myCommandLine.parse(2, (char**)no_input);
+    failed |= check("missing flag", (err & ERR_REQ_ARG_NOT_FOUND) && r.missing(ids, 8) == 1 && ids[0] == input->id);
+    failed |= check("isMissing", r.isMissing(input) && !r.isMissing(count));
+
+    const char* no_level[] = {"demo", "-i", "in.txt", "7", "-c"};
+    err = myCommandLine.parse(5, (char**)no_level);
+    failed |= check("positional between flags", r.integer(count) == 7);
+    failed |= check("required parameter of a given flag", (err & ERR_REQ_PARAM_NOT_FOUND) && r.missing(ids, 8) == 1 && ids[0] == level->id);
+
+    const char* no_count[] = {"demo", "-i", "in.txt"};
+    err = myCommandLine.parse(3, (char**)no_count);
+    failed |= check("missing positional", (err & ERR_REQ_PARAM_NOT_FOUND) && r.isMissing(count) && !r.isMissing(level));
+
+    const char* rejected[] = {"demo", "-i", "in.txt", "11"};
+    err = myCommandLine.parse(4, (char**)rejected);
+    failed |= check("rejected positional is out of range", (err & ERR_OUT_OF_RANGE) != 0);
+    failed |= check("rejected positional is absent", !r.has(count) && r.owner(3) == -1);
+    failed |= check("rejected positional stays missing", (err & ERR_REQ_PARAM_NOT_FOUND) && r.isMissing(count));
+
+    const char* nothing[] = {"demo"};
+    err = myCommandLine.parse(1, (char**)nothing);
+    failed |= check("every missing argument listed", r.missing(ids, 8) == 2 && r.missing(ids, 1) == 2);
+
+    return failed;
+}
@@ -0,0 +1,90 @@
+#include "iostream"
+#include "string.h"
+#include "../../src/commandline.hpp"
+
+/*
+ *  Rules between arguments: addExclusive(), addRequires(), addAtLeastOne() and Argument::addExclude(), each
+ *  violation is reported with the arguments involved. Exits with 1 if any check fails.
+ */
+
+int check(const char* what, bool ok){
+    std::cout << (ok ? "ok     " : "FAILED ") << what << std::endl;
+    return ok ? 0 : 1;
+}
+
+//the first diagnostic of the last parse contains text
+bool says(cli::CommandLine& cli, const char* text){
+    char buffer[256];
+    cli.describeError(buffer, sizeof(buffer));
+    return strstr(buffer, text) != nullptr;
+}
+
+int main(int argc, char** argv){
+
+
+    cli::CommandLineVerbosity = 0 ;
+    cli::CommandLine myCommandLine;
+
+    cli::Argument* json = cli::NewArgument(cli::OPTION, "j", "json", false, "Print json");
+    cli::Argument* yaml = cli::NewArgument(cli::OPTION, "y", "yaml", false, "Print yaml");
+    cli::Argument* output = cli::NewArgument(
+        cli::OPTION,
+        "o",
+        "output",
+        false,
+        "Write into a file"
+    )->addArgument(cli::NewParamter("path", "string"));
+    cli::Argument* append = cli::NewArgument(cli::OPTION, "a", "append", false, "Append to the output file");
+    cli::Argument* file = cli::NewArgument(
+        cli::OPTION,
+        "F",
+        "file",
+        false,
+        "Read from a file"
+    )->addArgument(cli::NewParamter("path", "string"));
+    cli::Argument* url = cli::NewArgument(
+        cli::OPTION,
+        "u",
+        "url",
+        false,
+        "Read from a url"
+    )->addArgument(cli::NewParamter("address", "string"));
+    cli::Argument* quiet = cli::NewArgument(cli::OPTION, "q", "quiet", false, "Print nothing")->addExclude("verbose");
+    cli::Argument* verbose = cli::NewArgument(cli::OPTION, "v", "verbose", false, "Print more");
+
+    cli::Argument* all[] = {json, yaml, output, append, file, url, quiet, verbose};
+    for (cli::Argument* arg : all)
+        myCommandLine.addArgument(arg);
+    myCommandLine.addExclusive({json, yaml});
+    myCommandLine.addRequires(append, {output});
+    myCommandLine.addAtLeastOne({file, url});
+
+
+    int failed = 0;
+
+    const char* fine[] = {"demo", "-j", "-F", "in.txt", "-o", "out.txt", "-a"};
+    int err = myCommandLine.parse(7, (char**)fine);
+    failed |= check("every rule holds", err == ERR_NO_ERR);
+
+    const char* both[] = {"demo", "-j", "-y", "-F", "in.txt"};
+    err = myCommandLine.parse(5, (char**)both);
+    failed |= check("json and yaml conflict", (err & ERR_CONFLICT) && says(myCommandLine, "--json conflicts with --yaml"));
+
+    const char* alone[] = {"demo", "-a", "-u", "http://example.org"};
+    err = myCommandLine.parse(4, (char**)alone);
+    failed |= check("append requires output", (err & ERR_DEPENDENCY) && says(myCommandLine, "--append requires --output"));
+
+    const char* neither[] = {"demo", "-j"};
+    err = myCommandLine.parse(2, (char**)neither);
+    failed |= check("one of file and url", (err & ERR_DEPENDENCY) && says(myCommandLine, "one of --file, --url is required"));
+
+    const char* excluded[] = {"demo", "-q", "-v", "-F", "in.txt"};
+    err = myCommandLine.parse(5, (char**)excluded);
+    failed |= check("addExclude is a conflict", (err & ERR_CONFLICT) && says(myCommandLine, "--quiet conflicts with --verbose"));
+
+    const char* several[] = {"demo", "-j", "-y", "-a"};
+    err = myCommandLine.parse(4, (char**)several);
+    failed |= check("every violation is reported", (err & ERR_CONFLICT) && (err & ERR_DEPENDENCY) && myCommandLine.parsed().diagnostic_count == 3);
+
+    return failed;
+}
@@ -42,10 +42,17 @@
  *       int err = myCommandLine.parse(argc, argv);
  *       cli::Options* cli_cntr = myCommandLine.parsedArgs();
  *
+ *  Or let the parser decode straight into your own struct, without any Options lookups:
+ *
+ *       struct Config { int port; };
+ *       myCommandLine.addArgument(cli::NewArgument(cli::OPTION, "p", "port", false, "The port")
+ *           ->addArgument(cli::NewParamter("number", "int")->bind(&Config::port)));
+ *       Config config;
+ *       int err = myCommandLine.parse(argc, argv, &config);
+ *
  *
  *  //TODO
  *      cleanUp
- *      allow repeated parameters for methods
  *      execute methods on selection
  *      operatoroverloading for Options
  *      create cli from config.json!
@@ -64,8 +71,44 @@
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
+#include <errno.h>
 #include <unistd.h>
 #include <initializer_list>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <atomic>
+#include <new>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <float.h>
+#include <locale.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(CLI_NO_SIMD)
+#define CLI_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#ifdef CLI_ENABLE_WATCHER
+#include <thread>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+#endif
+
+extern char **environ;
 
 /*
     DESCRIPTION:
@@ -91,6 +134,17 @@ namespace cli
 #define CLI_DTYPE_STRING 2
 #define CLI_DTYPE_URL 3
 #define CLI_DTYPE_FILE 4
+#define CLI_DTYPE_INT_LIST 5        //"int[]", separated integers decoded into ListValues
+#define CLI_DTYPE_DOUBLE_LIST 6     //"double[]"
+#define CLI_DTYPE_STRING_LIST 7     //"string[]"
+#define CLI_DTYPE_DOUBLE 8          //locale independent, '.' as decimal point
+#define CLI_DTYPE_BOOL 9            //1/true/yes/on, 0/false/no/off
+#define CLI_DTYPE_UINT64 10
+#define CLI_DTYPE_SIZE 11           //bytes, 4K, 16MiB, 2GB (binary units)
+#define CLI_DTYPE_DURATION 12       //nanoseconds, 250ms, 5m, 1h30m
+#define CLI_DTYPE_IPV4 13
+#define CLI_DTYPE_IPV6 14
+#define CLI_DTYPE_PORT 15           //0 to 65535
 
 #define CLI_DTYPE_UNDEF -1
 
@@ -106,6 +160,79 @@ namespace cli
 #define ERR_HELP_WILDCARD 32
 #define ERR_NOT_FOUND 64
 #define ERR_REQ_PARAM_NOT_FOUND 128
+#define ERR_CONFIG_FILE 256
+#define ERR_CAPACITY 512            //caller provided parse storage too small
+#define ERR_REPEATED 1024           //flag given again with CLI_REPEAT_ERROR
+#define ERR_OUT_OF_RANGE 2048       //value violates a min/max/step/power of two constraint, see CommandLine::describeError()
+#define ERR_CONFLICT 4096           //mutually exclusive arguments given together
+#define ERR_DEPENDENCY 8192         //an argument given without what it requires, or none of an at least one group
+
+//where a merged configuration value came from, higher wins
+#define CLI_SOURCE_NONE 0
+#define CLI_SOURCE_DEFAULT 1
+#define CLI_SOURCE_FILE 2
+#define CLI_SOURCE_ENV 3
+#define CLI_SOURCE_ARGV 4
+
+//what happens when a flag is given more than once (-I a -I b), see Argument::setRepeat()
+#define CLI_REPEAT_APPEND 0         //every value is kept, in argv order
+#define CLI_REPEAT_LAST 1           //only the last value is kept
+#define CLI_REPEAT_COUNT 2          //only the number of occurrences matters, the last value is kept
+#define CLI_REPEAT_ERROR 3          //a second occurrence is ERR_REPEATED
+
+//rules between arguments, see CommandLine::addExclusive()
+#define CLI_RULE_EXCLUSIVE 1
+#define CLI_RULE_REQUIRES 2
+#define CLI_RULE_ONE_OF 3
+
+//constraints of numeric parameters, see Argument::setRange()
+#define CLI_CHECK_MIN 1
+#define CLI_CHECK_MAX 2
+#define CLI_CHECK_STEP 4            //(value - min) is a multiple of step, min counts as 0 when not set
+#define CLI_CHECK_POW2 8            //integer dtypes only
+
+//problems kept per parse with their position, later ones are only counted, see ParseResult::diagnostics
+#define CLI_MAX_DIAGNOSTICS 16
+
+//characters assumed per argv token (and per environment value) when storageFor() reserves the list buffers without argv
+#ifndef CLI_LIST_RESERVE_CHARS
+#define CLI_LIST_RESERVE_CHARS 64
+#endif
+
+//message catalogs, see CommandLine::setCatalog()
+#define CLI_CATALOG_MAGIC "CLICAT1"
+#define CLI_CATALOG_ERRORS 16       //error messages per catalog, indexed by the bit position of the ERR_* code
+
+//parse tracing, compiled in with -DCLI_ENABLE_TRACE, see CommandLine::dumpTrace()
+#ifndef CLI_TRACE_CAPACITY
+#define CLI_TRACE_CAPACITY 256      //events kept per parse, older ones are overwritten
+#endif
+#define CLI_EVENT_PARSE_BEGIN 1     //detail: argc
+#define CLI_EVENT_MATCH 2           //a flag or method matched argv[index]
+#define CLI_EVENT_PARAM 3           //a parameter of the matched flag took argv[index]
+#define CLI_EVENT_POSITIONAL 4      //a positional parameter took argv[index]
+#define CLI_EVENT_UNKNOWN 5         //argv[index] matched nothing
+#define CLI_EVENT_REJECT 6          //a value was rejected, detail: the ERR_* bits
+#define CLI_EVENT_ENV 7             //an absent flag was taken from the environment
+#define CLI_EVENT_MISSING 8         //a required argument is missing
+#define CLI_EVENT_RULES 9           //rules between arguments checked, detail: the ERR_* bits
+#define CLI_EVENT_PARSE_END 10      //detail: the returned error mask
+
+//parse phases of the opt in profile, see CommandLine::setProfiling()
+#define CLI_PHASE_TOKENIZE 0        //scanning argv for the wildcards, hashing the tokens
+#define CLI_PHASE_MATCH 1           //flag, method and positional lookup, bindings
+#define CLI_PHASE_VALIDATE 2        //decoding values, choices, min/max/step constraints and dtype check callbacks
+#define CLI_PHASE_CONSTRAINT 3      //environment fallbacks, required arguments and rules between arguments
+#define CLI_PHASE_CALLBACK 4        //callbacks and methods run by CommandLine::execute()
+#define CLI_PHASE_COUNT 5
+#define CLI_SPAN_PARSE 5            //a whole parse, the phases nest in it
+#define CLI_SPAN_EXECUTE 6          //a whole CommandLine::execute()
+
+#ifdef CLI_ENABLE_TRACE
+#define CLI_TRACE(ring, event, id, index, detail) (ring).record(event, id, index, detail)
+#else
+#define CLI_TRACE(ring, event, id, index, detail) ((void)0)
+#endif
 
 
 #define _cli_arg_count 5
@@ -138,35 +265,198 @@ namespace cli
         CommandLineVerbosity = verbosity;
     }
 
+    /**
+     * @brief String primitives, picked once at runtime (AVX2, SSE2 or scalar)
+     *
+     * The vector versions only ever load aligned blocks (length) or blocks that do not cross a page (compare),
+     * so reading past the terminator can never fault. Define CLI_NO_SIMD to force the scalar versions.
+     */
+    struct _str_ops
+    {
+        int (*length)(const char* str);                                 // without the terminator
+        int (*compare)(const char* str1, const char* str2, int l);      // equal within the first l bytes or up to a shared '\0'
+        int (*digits)(const char* str, unsigned long long* value);      // decodes up to 16 leading decimal digits, returns how many
+    };
+
+    int _strlen_scalar(const char* str){
+        const char* p = str;
+        while (*p != '\0')
+            p++;
+        return p-str;
+    }
+
+    int _compare_scalar(const char* str1, const char* str2, int l){
+        for (int i=0;i<l;i++){
+            if (str1[i] != str2[i])
+                return 0;
+            if (str1[i] == '\0')
+                return 1;
+        }
+        return 1;
+    }
+
+    int _digits_scalar(const char* str, unsigned long long* value){
+        unsigned long long v = 0;
+        int n = 0;
+        while (n < 16 && str[n] >= '0' && str[n] <= '9'){
+            v = v*10 + (str[n]-'0');
+            n++;
+        }
+        *value = v;
+        return n;
+    }
+
+#ifdef CLI_SIMD_X86
+    static inline int _ctz(unsigned int mask){
+        return __builtin_ctz(mask);
+    }
+
+    //true if a block of n bytes starting at p stays inside its page
+    static inline bool _in_page(const char* p, int n){
+        return ((uintptr_t)p & 4095) <= (uintptr_t)(4096-n);
+    }
+
+    __attribute__((no_sanitize_address))
+    int _strlen_sse2(const char* str){
+        const __m128i zero = _mm_setzero_si128();
+        uintptr_t off = (uintptr_t)str & 15;
+        const char* p = str - off;
+        unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero)) >> off;
+        if (mask != 0)
+            return _ctz(mask);
+        for (p+=16;;p+=16){
+            mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)p), zero));
+            if (mask != 0)
+                return p+_ctz(mask)-str;
+        }
+    }
+
+    __attribute__((no_sanitize_address))
+    int _compare_sse2(const char* str1, const char* str2, int l){
+        int i = 0;
+        while (i < l){
+            if (l-i < 16 || !_in_page(str1+i, 16) || !_in_page(str2+i, 16)){
+                if (str1[i] != str2[i])
+                    return 0;
+                if (str1[i] == '\0')
+                    return 1;
+                i++;
+                continue;
+            }
+            __m128i a = _mm_loadu_si128((const __m128i*)(str1+i));
+            __m128i b = _mm_loadu_si128((const __m128i*)(str2+i));
+            unsigned int stop = ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFF;
+            stop |= _mm_movemask_epi8(_mm_cmpeq_epi8(a, _mm_setzero_si128()));
+            if (stop != 0){
+                int k = i+_ctz(stop);
+                return str1[k] == str2[k];
+            }
+            i += 16;
+        }
+        return 1;
+    }
+
+    /**
+     * @brief The digit run is right aligned with one shuffle, then folded pairwise (10, 100, 10000) into two 8 digit halves
+     */
+    __attribute__((target("ssse3,sse4.1"), no_sanitize_address))
+    int _digits_sse41(const char* str, unsigned long long* value){
+        if (!_in_page(str, 16))
+            return _digits_scalar(str, value);
+        __m128i d = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)str), _mm_set1_epi8('0'));
+        unsigned int other = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d)) & 0xFFFF;
+        int n = other != 0 ? _ctz(other) : 16;
+        if (n == 0){
+            *value = 0;
+            return 0;
+        }
+        //lane j takes digit j-(16-n), the negative indices in front select zero
+        __m128i shift = _mm_add_epi8(_mm_setr_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15), _mm_set1_epi8(n-16));
+        d = _mm_shuffle_epi8(d, shift);
+        __m128i t = _mm_maddubs_epi16(d, _mm_setr_epi8(10,1,10,1,10,1,10,1,10,1,10,1,10,1,10,1));
+        t = _mm_madd_epi16(t, _mm_setr_epi16(100,1,100,1,100,1,100,1));
+        t = _mm_packus_epi32(t, t);
+        t = _mm_madd_epi16(t, _mm_setr_epi16(10000,1,10000,1,10000,1,10000,1));
+        *value = (unsigned long long)(unsigned int)_mm_cvtsi128_si32(t)*100000000ull + (unsigned int)_mm_extract_epi32(t, 1);
+        return n;
+    }
+
+    __attribute__((target("avx2"), no_sanitize_address))
+    int _strlen_avx2(const char* str){
+        const __m256i zero = _mm256_setzero_si256();
+        uintptr_t off = (uintptr_t)str & 31;
+        const char* p = str - off;
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), zero)) >> off;
+        if (mask != 0)
+            return _ctz(mask);
+        for (p+=32;;p+=32){
+            mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i*)p), zero));
+            if (mask != 0)
+                return p+_ctz(mask)-str;
+        }
+    }
+
+    __attribute__((target("avx2"), no_sanitize_address))
+    int _compare_avx2(const char* str1, const char* str2, int l){
+        int i = 0;
+        while (i < l){
+            if (l-i < 32 || !_in_page(str1+i, 32) || !_in_page(str2+i, 32))
+                return _compare_sse2(str1+i, str2+i, l-i);
+            __m256i a = _mm256_loadu_si256((const __m256i*)(str1+i));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(str2+i));
+            unsigned int stop = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+            stop |= (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, _mm256_setzero_si256()));
+            if (stop != 0){
+                int k = i+_ctz(stop);
+                return str1[k] == str2[k];
+            }
+            i += 32;
+        }
+        return 1;
+    }
+#endif
+
+    _str_ops _select_str_ops(){
+        _str_ops ops;
+        ops.length = _strlen_scalar;
+        ops.compare = _compare_scalar;
+        ops.digits = _digits_scalar;
+#ifdef CLI_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.1"))
+            ops.digits = _digits_sse41;
+        if (__builtin_cpu_supports("avx2")){
+            ops.length = _strlen_avx2;
+            ops.compare = _compare_avx2;
+        } else if (__builtin_cpu_supports("sse2")){
+            ops.length = _strlen_sse2;
+            ops.compare = _compare_sse2;
+        }
+#endif
+        return ops;
+    }
+
+    const _str_ops& _cli_str_ops(){
+        static const _str_ops ops = _select_str_ops();
+        return ops;
+    }
+
+    //length including the terminating '\0', what every buffer in here is allocated with
     int strlen(const char* str){
-        for(int i=0;;i++)
-            if (str[i] == '\0')
-                return i+1;
-        return 0;
+        return _cli_str_ops().length(str)+1;
     }
 
 
     void write_string(char* dst, char* src){
-        for (int i=0;i<strlen(src);i++)
-            dst[i] = src[i];
-        
+        memcpy(dst, src, strlen(src));
     }
     int _compare_cstring(const char* str1, char* str2){
-        int l = strlen(str1);
-        if (l != strlen(str2)){
-            return 0;
-        }
-        int same = 1;
-        for (int i=0;i<l;i++)
-            same = same && (str1[i] == str2[i]);
-        return same;
+        return _cli_str_ops().compare(str1, str2, INT_MAX);
     }   
 
+    //the first l characters are equal, a string ending earlier only matches the same string
     int _compare_cstring_until(char* str1, char* str2, int l){
-        int same = 1;
-        for (int i=0;i<l;i++)
-            same = same && (str1[i] == str2[i]);
-        return same;
+        return _cli_str_ops().compare(str1, str2, l);
     }
 
     char* combineString(char* str1, char* str2){
@@ -174,14 +464,273 @@ namespace cli
         int l2 = strlen(str2);
         int l = l1 + l2-1;
         char* r = new char[l];
-        for (int i=0;i<l1-1;i++)
-            r[i] = str1[i];
-        for (int i=0;i<l2;i++)
-            r[i+l1-1] = str2[i];
+        memcpy(r, str1, l1-1);
+        memcpy(r+l1-1, str2, l2);
         return r;    
     }
 
 
+    uint32_t _hash_flag(const char* str){
+        uint32_t h = 2166136261u;
+        for (int i=0;str[i] != '\0';i++)
+            h = (h ^ (unsigned char)str[i]) * 16777619u;
+        return h;
+    }
+
+    /**
+     * @brief Interning pool for all schema strings (flags, dtype names, help texts once they are decompressed)
+     *
+     * Every distinct string is stored once in a chain of never moving blocks, equal strings share one pointer.
+     * An open addressing table over the hashes finds existing copies, strings are never freed.
+     */
+    struct _string_pool
+    {
+        std::vector<char*>                      blocks;
+        int                                     used;       // bytes used in blocks.back()
+        std::vector<const char*>                table;      // power of two sized, nullptr = empty
+        std::vector<uint32_t>                   hashes;
+        int                                     count;
+
+        _string_pool(){
+            this->used = 0;
+            this->count = 0;
+            this->table.assign(64, nullptr);
+            this->hashes.assign(64, 0);
+        };
+
+        const char* intern(const char* str){
+            uint32_t h = _hash_flag(str);
+            unsigned int mask = this->table.size()-1;
+            unsigned int slot = h & mask;
+            for (;this->table[slot] != nullptr;slot = (slot+1) & mask)
+                if (this->hashes[slot] == h && _compare_cstring(str, (char*)this->table[slot]))
+                    return this->table[slot];
+
+            int l = strlen(str);
+            if (this->blocks.size() == 0 || this->used + l > 4096){
+                this->blocks.push_back((char*)malloc(l > 4096 ? l : 4096));
+                this->used = 0;
+            }
+            char* copy = this->blocks.back() + this->used;
+            write_string(copy, (char*)str);
+            this->used += l;
+
+            this->table[slot] = copy;
+            this->hashes[slot] = h;
+            if (++this->count*2 > (int)this->table.size())
+                this->grow();
+            return copy;
+        };
+
+        void grow(){
+            std::vector<const char*> table(this->table.size()*2, nullptr);
+            std::vector<uint32_t> hashes(this->table.size()*2, 0);
+            unsigned int mask = table.size()-1;
+            for (int i=0;i<(int)this->table.size();i++){
+                if (this->table[i] == nullptr)
+                    continue;
+                unsigned int slot = this->hashes[i] & mask;
+                while (table[slot] != nullptr)
+                    slot = (slot+1) & mask;
+                table[slot] = this->table[i];
+                hashes[slot] = this->hashes[i];
+            }
+            this->table.swap(table);
+            this->hashes.swap(hashes);
+        };
+    };
+
+    _string_pool& _cli_strings(){
+        static _string_pool pool;
+        return pool;
+    }
+
+    //the pooled copy of str, equal strings always return the same pointer
+    char* _intern(const char* str){
+        return (char*)_cli_strings().intern(str);
+    }
+
+    //a run length of 15 or more continues in bytes of 255, the first smaller byte ends it
+    void _lz_length(std::vector<char>* out, int n){
+        for (;n >= 255;n -= 255)
+            out->push_back((char)255);
+        out->push_back((char)n);
+    }
+
+    /**
+     * @brief Byte oriented LZ77 in the spirit of LZ4, appended to out
+     *
+     * Every sequence is a token (literal count << 4 | match length-4, 15 = continued), the literals, a 16 bit
+     * little endian offset back into the output and the rest of the match length. The last sequence has literals only.
+     */
+    void _lz_compress(const char* src, int n, std::vector<char>* out){
+        int table[4096];
+        for (int k=0;k<4096;k++)
+            table[k] = -1;
+        int anchor = 0;
+        for (int i=0;i+4 <= n;){
+            uint32_t seq;
+            memcpy(&seq, src+i, 4);
+            int h = (seq*2654435761u) >> 20;
+            int candidate = table[h];
+            table[h] = i;
+            if (candidate < 0 || i-candidate > 65535 || memcmp(src+candidate, src+i, 4) != 0){
+                i++;
+                continue;
+            }
+            int length = 4;
+            while (i+length < n && src[candidate+length] == src[i+length])
+                length++;
+            int literals = i-anchor;
+            out->push_back((char)((literals < 15 ? literals : 15) << 4 | (length-4 < 15 ? length-4 : 15)));
+            if (literals >= 15)
+                _lz_length(out, literals-15);
+            out->insert(out->end(), src+anchor, src+i);
+            out->push_back((char)((i-candidate) & 0xFF));
+            out->push_back((char)((i-candidate) >> 8));
+            if (length-4 >= 15)
+                _lz_length(out, length-4-15);
+            i += length;
+            anchor = i;
+        }
+        int literals = n-anchor;
+        out->push_back((char)((literals < 15 ? literals : 15) << 4));
+        if (literals >= 15)
+            _lz_length(out, literals-15);
+        out->insert(out->end(), src+anchor, src+n);
+    }
+
+    //inverse of _lz_compress, returns the bytes written to dst or -1 for input that does not fit into capacity
+    int _lz_decompress(const char* src, int n, char* dst, int capacity){
+        const unsigned char* in = (const unsigned char*)src;
+        int s = 0;
+        int d = 0;
+        while (s < n){
+            int token = in[s++];
+            int literals = token >> 4;
+            for (int b = 255;literals >= 15 && b == 255 && s < n;literals += b)
+                b = in[s++];
+            if (literals > n-s || literals > capacity-d)
+                return -1;
+            memcpy(dst+d, src+s, literals);
+            s += literals;
+            d += literals;
+            if (s >= n)
+                break;
+            if (s+2 > n)
+                return -1;
+            int offset = in[s] | in[s+1] << 8;
+            s += 2;
+            int length = token & 15;
+            for (int b = 255;length >= 15 && b == 255 && s < n;length += b)
+                b = in[s++];
+            length += 4;
+            if (offset == 0 || offset > d || length > capacity-d)
+                return -1;
+            for (int k=0;k<length;k++,d++)
+                dst[d] = dst[d-offset];
+        }
+        return d;
+    }
+
+    //one independently compressed run of help texts
+    struct _help_block
+    {
+        int                                     base;       // raw offset of the first text
+        int                                     raw_size;
+        std::vector<char>                       data;
+    };
+
+    /**
+     * @brief Help texts of the arguments of one tree, compressed in blocks and decompressed only when help is rendered
+     *
+     * add() appends a text to the raw staging area and returns its raw offset as handle, pack() (called when a schema
+     * is finalized) compresses everything staged into blocks of about 16KB, cut between texts, and frees the staging.
+     * get() decompresses one whole block into a one block cache, the only decompressed copy, so rendering the help of
+     * a subcommand decompresses the few blocks its texts live in and nothing stays resident twice.
+     */
+    struct _help_store
+    {
+        std::vector<_help_block>                blocks;
+        std::vector<char>                       staging;    // raw texts since the last pack(), each '\0' terminated
+        int                                     packed;     // raw bytes in blocks
+        std::vector<char>                       cache;      // the decompressed cached_block
+        int                                     cached_block;
+
+        _help_store(){
+            this->packed = 0;
+            this->cached_block = -1;
+        };
+
+        int add(const char* text){
+            int handle = this->packed + this->staging.size();
+            this->staging.insert(this->staging.end(), text, text+strlen(text));
+            return handle;
+        };
+
+        void pack(){
+            int begin = 0;
+            for (int k=0;k<(int)this->staging.size();k++){
+                if (this->staging[k] != '\0' || (k+1-begin < 16384 && k+1 < (int)this->staging.size()))
+                    continue;
+                _help_block block;
+                block.base = this->packed + begin;
+                block.raw_size = k+1-begin;
+                _lz_compress(&this->staging[begin], block.raw_size, &block.data);
+                std::vector<char>(block.data).swap(block.data);
+                this->blocks.push_back(block);
+                begin = k+1;
+            }
+            this->packed += this->staging.size();
+            std::vector<char>().swap(this->staging);
+        };
+
+        //the text at handle, valid until the next add() or get()
+        const char* get(int handle){
+            if (handle >= this->packed)
+                return &this->staging[handle-this->packed];
+            int b = this->blocks.size()-1;
+            while (this->blocks[b].base > handle)
+                b--;
+            if (this->cached_block != b){
+                this->cache.resize(this->blocks[b].raw_size);
+                _lz_decompress(this->blocks[b].data.data(), this->blocks[b].data.size(), this->cache.data(), this->blocks[b].raw_size);
+                this->cached_block = b;
+            }
+            return &this->cache[handle-this->blocks[b].base];
+        };
+    };
+
+    //maps the dtype name of a parameter onto its CLI_DTYPE_* code
+    int _dtype_code(const char* dtype){
+        if (_compare_cstring("int", (char*)dtype))
+            return CLI_DTYPE_INT;
+        if (_compare_cstring("string", (char*)dtype))
+            return CLI_DTYPE_STRING;
+        if (_compare_cstring("url", (char*)dtype))
+            return CLI_DTYPE_URL;
+        if (_compare_cstring("file", (char*)dtype))
+            return CLI_DTYPE_FILE;
+        if (_compare_cstring("int[]", (char*)dtype))
+            return CLI_DTYPE_INT_LIST;
+        if (_compare_cstring("double[]", (char*)dtype))
+            return CLI_DTYPE_DOUBLE_LIST;
+        if (_compare_cstring("string[]", (char*)dtype))
+            return CLI_DTYPE_STRING_LIST;
+        const char* names[] = {"double", "bool", "uint64", "size", "duration", "ipv4", "ipv6", "port"};
+        for (int i=0;i<8;i++)
+            if (_compare_cstring(names[i], (char*)dtype))
+                return CLI_DTYPE_DOUBLE+i;
+        return CLI_DTYPE_UNDEF;
+    }
+
+    //the dtype name for a CLI_DTYPE_* code, "value" for unknown codes
+    const char* _dtype_name(int code){
+        const char* names[] = {"int", "string", "url", "file", "int[]", "double[]", "string[]", 
+                               "double", "bool", "uint64", "size", "duration", "ipv4", "ipv6", "port"};
+        return code >= CLI_DTYPE_INT && code <= CLI_DTYPE_PORT ? names[code-CLI_DTYPE_INT] : "value";
+    }
+
     //Check wether the given argument type of any argument is ok, and can be used properly if not throw an exception
     //returns 0 = false when arg_type is not wellformed, otherwise returns 1 as true
     const int _checkArgType(ArgumentType arg_type){
@@ -293,6 +842,7 @@ namespace cli
         private: 
             ArgumentType arg_type;
             char*   key;                    //represents the long flag from the cli argument
+            bool    own_key;                //false when key points into the string pool (setKeyRef)
 
             char*   data;                   //the exact entered argv on call time
 
@@ -307,14 +857,16 @@ namespace cli
                 this->argc = 0;
                 this->argv = std::vector<char*> ();
                 this->arg_type = _NULL_ARG_;
-                this->setKey("__null__");
+                this->own_key = false;
+                this->data = nullptr;
+                this->setKeyRef("__null__");
                 this->setData("__null__");    
                 
             }
             Options* operator[](const char* key){
                 Options* option  = new Options();;
                 for (int i=0;i<this->argc;i++)
-                    if (_compare_cstring(key, this->options[i]->key))
+                    if (key == this->options[i]->key || _compare_cstring(key, this->options[i]->key))
                         {
                             option =  this->options[i];
                             return option;
@@ -324,7 +876,7 @@ namespace cli
             Options* get(const char* key){
                 Options* option = new Options();
                 for (int i=0;i<this->argc;i++)
-                    if (_compare_cstring(key, this->options[i]->key))
+                    if (key == this->options[i]->key || _compare_cstring(key, this->options[i]->key))
                         {
                             option =  this->options[i];
                             return option;
@@ -332,20 +884,34 @@ namespace cli
                 return option;
             };
             ~Options(){
-                delete(this->key);
+                if (this->own_key)
+                    free(this->key);
+                free(this->data);
                 for (char* a:this->argv)
                     delete(a);
-                delete(&this->options);
             }
             void setArgType(ArgumentType t){
                 this->arg_type = t;
             }
+            ArgumentType getArgType(){
+                return this->arg_type;
+            }
             char* getKey(){
                 return this->key;
             }
             void setKey(char* key){
+                if (this->own_key)
+                    free(this->key);
                 this->key = (char*)malloc(strlen(key));
                 write_string(this->key, key);
+                this->own_key = true;
+            }
+            //shares a string that outlives the node (pooled schema strings, literals) instead of copying it
+            void setKeyRef(const char* key){
+                if (this->own_key)
+                    free(this->key);
+                this->key = (char*)key;
+                this->own_key = false;
             }
             void setParsed(bool parsed){
                 this->parsed = parsed;
@@ -362,6 +928,9 @@ namespace cli
             void addOptions(Options* options){
                 this->options.push_back(options);
             }
+            Options* getOption(int i){
+                return this->options[i];
+            }
             void addArgv(char* argument){
                 this->argv.push_back(argument);
             }
@@ -369,6 +938,7 @@ namespace cli
                 return this->argv;
             }
             void setData(char* data){
+                free(this->data);
                 this->data = (char*)malloc(strlen(data));
                 write_string(this->data, data);
             }
@@ -396,10 +966,11 @@ namespace cli
             }
     };
 
+    //one generic line for an error mask, CommandLine::describe() explains the single problems of a parse
     const char *ErrParse(int ErrCode)
     {
         if (ErrCode & ERR_HELP_WILDCARD){
-            if (ErrCode & 0xFE == 0)
+            if ((ErrCode & ~(ERR_NO_ERR | ERR_HELP_WILDCARD)) == 0)
             {
                 return "<Help - Wildhard> No Error.\n";
             }
@@ -417,7 +988,7 @@ namespace cli
             }
         }
         
-        if (ErrCode & 0xFE == 0)
+        if ((ErrCode & ~ERR_NO_ERR) == 0)
         {
             return "No Error.\n";
         }
@@ -433,9 +1004,299 @@ namespace cli
         if (ErrCode & ERR_REQ_PARAM_NOT_FOUND){
             return "Required Parameter could not be found.\n";
         }
+        if (ErrCode & ERR_UNKOWN_INPUT){
+            return "Unknown Argument.\n";
+        }
+        if (ErrCode & ERR_REPEATED){
+            return "Argument given more than once.\n";
+        }
+        if (ErrCode & ERR_OUT_OF_RANGE){
+            return "Value out of range.\n";
+        }
+        if (ErrCode & ERR_CONFLICT){
+            return "Conflicting Arguments.\n";
+        }
+        if (ErrCode & ERR_DEPENDENCY){
+            return "Argument dependency not met.\n";
+        }
+        if (ErrCode & ERR_CAPACITY){
+            return "Parse storage too small.\n";
+        }
+        if (ErrCode & ERR_CONFIG_FILE){
+            return "Config file could not be read.\n";
+        }
         return "Err - No Error Description found. sanity check advised or run with higher verbosity (if possible).\n";
     };
 
+    //the single ERR_* bit ErrParse() describes for an error mask without ERR_HELP_WILDCARD, 0 if it has no description
+    int _err_described(int ErrCode){
+        if ((ErrCode & ~ERR_NO_ERR) == 0)
+            return ERR_NO_ERR;
+        const int order[] = {ERR_INVALID_INPUT, ERR_REQ_ARG_NOT_FOUND, ERR_WRONG_DATA, ERR_REQ_PARAM_NOT_FOUND, ERR_UNKOWN_INPUT, 
+                             ERR_REPEATED, ERR_OUT_OF_RANGE, ERR_CONFLICT, ERR_DEPENDENCY, ERR_CAPACITY, ERR_CONFIG_FILE};
+        for (int i=0;i<(int)(sizeof(order)/sizeof(order[0]));i++)
+            if (ErrCode & order[i])
+                return order[i];
+        return 0;
+    }
+
+    /**************************************************************************************************************************************
+     * BINDINGS
+     *
+    */
+    /**
+     * @brief A type erased destination for a parsed value
+     *
+     * Either points directly at a variable (reference binding) or keeps a pointer-to-member, which is resolved
+     * against the struct handed to CommandLine::parse(argc, argv, &dst) right before parsing starts. Parsing
+     * without a destination clears it, a parse with member bindings then fails with ERR_NOT_FOUND.
+     * The parser decodes the matched argv value with store() straight into target, no Options node required.
+     */
+    struct _binding
+    {
+        void*                                   target;                             // the resolved destination, written while parsing
+        void*                                   member[2];                          // the pointer-to-member itself, copied in by bind()
+        void*                                   (*resolve)(const void* member, void* base); // nullptr for reference bindings
+        int                                     (*store)(void* dst, const char* value); // value is nullptr for flags without parameters
+    };
+
+    int _decode_bool(const char* value, bool* out){
+        if (value == nullptr){
+            *out = true;
+            return ERR_NO_ERR;
+        }
+        const char* t[] = {"1", "true", "yes", "on"};
+        const char* f[] = {"0", "false", "no", "off"};
+        for (int i=0;i<4;i++){
+            if (_compare_cstring(t[i], (char*)value)){
+                *out = true;
+                return ERR_NO_ERR;
+            }
+            if (_compare_cstring(f[i], (char*)value)){
+                *out = false;
+                return ERR_NO_ERR;
+            }
+        }
+        return ERR_WRONG_DATA;
+    }
+
+    //decodes a signed integer with range check, flags without parameters count up (-v -v -v)
+    template <typename T>
+    int _store_signed(void* dst, const char* value, long long lo, long long hi){
+        if (value == nullptr){
+            *(T*)dst += 1;
+            return ERR_NO_ERR;
+        }
+        char* end;
+        errno = 0;
+        long long number = strtoll(value, &end, 0);
+        if (end == value || *end != '\0' || errno == ERANGE || number < lo || number > hi)
+            return ERR_WRONG_DATA;
+        *(T*)dst = (T)number;
+        return ERR_NO_ERR;
+    }
+
+    template <typename T>
+    int _store_unsigned(void* dst, const char* value, unsigned long long hi){
+        if (value == nullptr){
+            *(T*)dst += 1;
+            return ERR_NO_ERR;
+        }
+        char* end;
+        errno = 0;
+        if (value[0] == '-')
+            return ERR_WRONG_DATA;
+        unsigned long long number = strtoull(value, &end, 0);
+        if (end == value || *end != '\0' || errno == ERANGE || number > hi)
+            return ERR_WRONG_DATA;
+        *(T*)dst = (T)number;
+        return ERR_NO_ERR;
+    }
+
+    template <typename T>
+    int _store_floating(void* dst, const char* value){
+        if (value == nullptr)
+            return ERR_NO_ERR;
+        char* end;
+        errno = 0;
+        double number = strtod(value, &end);
+        if (end == value || *end != '\0' || errno == ERANGE)
+            return ERR_WRONG_DATA;
+        *(T*)dst = (T)number;
+        return ERR_NO_ERR;
+    }
+
+    /**
+     * @brief Maps a bound C++ type onto its decoder, unsupported types fail to compile
+     */
+    template <typename T> struct _bind_traits;
+
+    template <> struct _bind_traits<bool>{
+        static int store(void* dst, const char* value){ return _decode_bool(value, (bool*)dst); }
+    };
+    template <> struct _bind_traits<int>{
+        static int store(void* dst, const char* value){ return _store_signed<int>(dst, value, INT_MIN, INT_MAX); }
+    };
+    template <> struct _bind_traits<long>{
+        static int store(void* dst, const char* value){ return _store_signed<long>(dst, value, LONG_MIN, LONG_MAX); }
+    };
+    template <> struct _bind_traits<long long>{
+        static int store(void* dst, const char* value){ return _store_signed<long long>(dst, value, LLONG_MIN, LLONG_MAX); }
+    };
+    template <> struct _bind_traits<unsigned int>{
+        static int store(void* dst, const char* value){ return _store_unsigned<unsigned int>(dst, value, UINT_MAX); }
+    };
+    template <> struct _bind_traits<unsigned long>{
+        static int store(void* dst, const char* value){ return _store_unsigned<unsigned long>(dst, value, ULONG_MAX); }
+    };
+    template <> struct _bind_traits<unsigned long long>{
+        static int store(void* dst, const char* value){ return _store_unsigned<unsigned long long>(dst, value, ULLONG_MAX); }
+    };
+    template <> struct _bind_traits<float>{
+        static int store(void* dst, const char* value){ return _store_floating<float>(dst, value); }
+    };
+    template <> struct _bind_traits<double>{
+        static int store(void* dst, const char* value){ return _store_floating<double>(dst, value); }
+    };
+    template <> struct _bind_traits<std::string>{
+        static int store(void* dst, const char* value){
+            if (value != nullptr)
+                ((std::string*)dst)->assign(value);
+            return ERR_NO_ERR;
+        }
+    };
+    //points into argv, which outlives the parse
+    template <> struct _bind_traits<const char*>{
+        static int store(void* dst, const char* value){
+            if (value != nullptr)
+                *(const char**)dst = value;
+            return ERR_NO_ERR;
+        }
+    };
+
+    template <typename S, typename T>
+    struct _bind_member
+    {
+        static void* resolve(const void* member, void* base){
+            T S::* m;
+            memcpy(&m, member, sizeof(m));
+            return base != nullptr ? &(((S*)base)->*m) : nullptr;
+        }
+    };
+
+    //one limit of a constraint, in the representation of the parameters dtype
+    union _limit
+    {
+        long long                               integer;
+        unsigned long long                      uinteger;
+        double                                  real;
+    };
+
+    /**
+     * @brief Numeric constraints of a parameter, checked right after the value was decoded
+     */
+    struct _constraint
+    {
+        uint8_t                                 checks;         // CLI_CHECK_*
+        _limit                                  min;
+        _limit                                  max;
+        _limit                                  step;
+    };
+
+    /**
+     * @brief Perfect hash (hash and displace) over the choices of one parameter, built by argument_tree::finalize()
+     *
+     * A choice falls into a bucket, every bucket has a displacement that moves its choices into free slots.
+     * A lookup hashes the string once, mixes twice and does one string compare.
+     */
+    struct _choice_hash
+    {
+        uint32_t                                bucket_mask;
+        uint32_t                                mask;
+        std::vector<uint16_t>                   displace;       // per bucket
+        std::vector<int32_t>                    slots;          // choice index, -1 = empty
+    };
+
+    uint64_t _choice_key(const char* str){
+        uint64_t h = 14695981039346656037ull;
+        for (int i=0;str[i] != '\0';i++)
+            h = (h ^ (unsigned char)str[i]) * 1099511628211ull;
+        return h;
+    }
+
+    uint32_t _choice_mix(uint64_t key, uint32_t displace){
+        uint64_t h = key + displace * 0x9E3779B97F4A7C15ull;
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+        return (uint32_t)(h ^ (h >> 31));
+    }
+
+    //how the decoded value of a dtype compares: 0 not numeric, 1 signed, 2 unsigned, 3 floating point
+    int _dtype_kind(int dtype){
+        switch (dtype){
+            case CLI_DTYPE_INT:
+            case CLI_DTYPE_DURATION:
+            case CLI_DTYPE_INT_LIST:
+                return 1;
+            case CLI_DTYPE_UINT64:
+            case CLI_DTYPE_SIZE:
+            case CLI_DTYPE_PORT:
+                return 2;
+            case CLI_DTYPE_DOUBLE:
+            case CLI_DTYPE_DOUBLE_LIST:
+                return 3;
+        }
+        return 0;
+    }
+
+    //a limit in the representation of dtype, saturated to its range instead of an out of range conversion
+    _limit _limit_of(int dtype, double v){
+        _limit limit;
+        int kind = _dtype_kind(dtype);
+        if (kind == 1)
+            limit.integer = v != v ? 0 : v <= -9223372036854775808.0 ? LLONG_MIN : v >= 9223372036854775808.0 ? LLONG_MAX : (long long)v;
+        else if (kind == 2)
+            limit.uinteger = !(v > 0) ? 0 : v >= 18446744073709551616.0 ? ULLONG_MAX : (unsigned long long)v;
+        else
+            limit.real = v;
+        return limit;
+    }
+    _limit _limit_of(int dtype, long long v){
+        _limit limit;
+        int kind = _dtype_kind(dtype);
+        if (kind == 1)
+            limit.integer = v;
+        else if (kind == 2)
+            limit.uinteger = v < 0 ? 0 : (unsigned long long)v;
+        else
+            limit.real = (double)v;
+        return limit;
+    }
+    _limit _limit_of(int dtype, unsigned long long v){
+        _limit limit;
+        int kind = _dtype_kind(dtype);
+        if (kind == 1)
+            limit.integer = v > (unsigned long long)LLONG_MAX ? LLONG_MAX : (long long)v;
+        else if (kind == 2)
+            limit.uinteger = v;
+        else
+            limit.real = (double)v;
+        return limit;
+    }
+
+    //floating point limits as double, signed integers as long long, unsigned ones as unsigned long long
+    template <typename T>
+    typename std::conditional<std::is_floating_point<T>::value, double, 
+             typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type>::type _widen(T v){
+        return v;
+    }
+
+    //"-3", "-.5" or "-1,2" for a signed or floating point dtype, a value rather than a flag
+    bool _negative_value(int dtype, const char* tok){
+        int kind = _dtype_kind(dtype);
+        return (kind == 1 || kind == 3) && tok[0] == '-' && (isdigit((unsigned char)tok[1]) || (tok[1] == '.' && isdigit((unsigned char)tok[2])));
+    }
+
     /**************************************************************************************************************************************
      * ARGUMENT
      * 
@@ -473,12 +1334,15 @@ namespace cli
         char*                                   short_flag;// if available and no parameters are needed => has no "arguments" allow for combination
         char**                                  excludes; // if any of the excluded arguments are present, throw an error and escape
         int                                     exclude_count;
-        // help single liner for that this cli argument needs as a paramteroo
+        // help single liner for that this cli argument needs as a paramteroo, a copy until the tree is finalized (nullptr after),
+        // read it through _help_of()
         char*                                   help_msg;
+        int                                     help_ref;   // handle into argument_tree::help_texts, -1 while pending or without help
 
         // is this a parameter and has available choices or is required
         char**                                  choices;
         int                                     choice_count;
+        _choice_hash                            choice_hash;
         // is this flag, option, method or parameter required
         bool                                    required;
 
@@ -494,6 +1358,24 @@ namespace cli
         std::vector<Argument*>                  arguments; //can be parameters of followup options
         Argument *parent; // first one is root, eg the program itself, can be captured then with arguments[0]
 
+        // where the parser writes the decoded value to, see bind()
+        _binding                                binding;
+
+        // environment variable used when the flag is absent from argv, see setEnv()
+        char*                                   env_name;
+        char*                                   env_value; // resolved once per parse from environ
+
+        // dense index into the CommandLine, assigned in CommandLine::addArgument, -1 while unregistered
+        int                                     id;
+        // lowest layer of a merged configuration, see CommandLine::merge()
+        char*                                   default_value;
+        // CLI_REPEAT_*, parameters without their own policy follow their flag
+        int                                     repeat;
+        // between the elements of a list dtype (int[], double[], string[])
+        char                                    separator;
+        // min/max/step/power of two, applies to every decoded value (also each list element)
+        _constraint                             constraint;
+
     /**
      * @brief Constructors
      * 
@@ -520,31 +1402,492 @@ namespace cli
         Argument *setDatatypeCheckCallback(int (*func)(const char* d));
         ArgumentType getArgType();
         Argument *setRequired(bool rqrd);
+        Argument *setEnv(char* name);
+        Argument *setDefault(char* value);
+        Argument *setRepeat(int policy);
+        Argument *setSeparator(char separator);
+        Argument *_setLimit(int check, _limit limit);
+        Argument *setPowerOfTwo();
+        Argument *addExclude(char* long_flag);
+
+        /**
+         * @brief Bounds for a numeric parameter, inclusive, checked while parsing (ERR_OUT_OF_RANGE)
+         *
+         *      cli::NewParamter("port", "port")->setRange(1024, 65535);
+         *      cli::NewParamter("ratio", "double")->setRange(0, 1.0)->setStep(0.25);
+         *
+         * The limits are converted to the dtype of the parameter (saturating at its range), so set the dtype first
+         * (NewParamter does).
+         * Double steps like 0.1 are not exact in binary, a value passes when (value - min) / step is within a few ulps
+         * of a whole number.
+         */
+        template <typename A, typename B>
+        Argument *setRange(A min, B max){
+            return this->setMin(min)->setMax(max);
+        };
+        template <typename T>
+        Argument *setMin(T min){
+            return this->_setLimit(CLI_CHECK_MIN, _limit_of(this->dtype, _widen(min)));
+        };
+        template <typename T>
+        Argument *setMax(T max){
+            return this->_setLimit(CLI_CHECK_MAX, _limit_of(this->dtype, _widen(max)));
+        };
+        template <typename T>
+        Argument *setStep(T step){
+            return this->_setLimit(CLI_CHECK_STEP, _limit_of(this->dtype, _widen(step)));
+        };
+
+        /**
+         * @brief Let the parser decode this argument straight into a variable, without an Options lookup afterwards
+         *
+         *      int port = 80;
+         *      cli::NewParamter("number", "int")->bind(&port);
+         *
+         * Flags without parameters bound to bool are set to true, bound to an integer they count their occurrences.
+         */
+        template <typename T>
+        Argument *bind(T* target){
+            this->binding.target  = (void*)target;
+            this->binding.resolve = nullptr;
+            this->binding.store   = &_bind_traits<T>::store;
+            return this;
+        };
+        /**
+         * @brief Bind to a field of a struct, resolved against the destination given to CommandLine::parse(argc, argv, &dst)
+         *
+         *      struct Config { int port; bool debug; };
+         *      cli::NewParamter("number", "int")->bind(&Config::port);
+         */
+        template <typename S, typename T>
+        Argument *bind(T S::* member){
+            static_assert(sizeof(member) <= sizeof(this->binding.member), "pointer-to-member does not fit the binding");
+            this->binding.target  = nullptr;
+            memcpy(this->binding.member, &member, sizeof(member));
+            this->binding.resolve = &_bind_member<S, T>::resolve;
+            this->binding.store   = &_bind_traits<T>::store;
+            return this;
+        };
         //std::vector<Argument> getArguments();
         char* string(char* spacer);
-        int parse(int argc, char** argv, Options* options);
     };
 
-     /**
-     * @brief THE ARGPRASE FUNCTION
-     * 
-     * Can also be used to sanity check arguments vs the argv input
-     * 
-     */
-    int parseArg(Argument* arg, char* thearg){
-
-
-        if (arg->arg_type&OPTION)
-            if (_compare_cstring(thearg, combineString(_argtype_header(arg->arg_type, "long") ,arg->long_flag)) || 
-                _compare_cstring(thearg, combineString(_argtype_header(arg->arg_type, "short") ,arg->short_flag))){
-            return ERR_NO_ERR;
+    //index of value in the choices of arg, -1 if it is none of them
+    int _choice_index(const Argument* arg, const char* value){
+        const _choice_hash& table = arg->choice_hash;
+        if (table.slots.size() == 0){
+            for (int i=0;i<arg->choice_count;i++)
+                if (_compare_cstring(value, arg->choices[i]))
+                    return i;
+            return -1;
         }
-        if (arg->arg_type&WILDCARD)
-            if (_compare_cstring(thearg, combineString(_argtype_header(arg->arg_type, "long") ,arg->long_flag)) || 
-                _compare_cstring(thearg, combineString(_argtype_header(arg->arg_type, "short") ,arg->short_flag))){
-                    return ERR_NO_ERR;
+        uint64_t key = _choice_key(value);
+        int i = table.slots[_choice_mix(key, table.displace[_choice_mix(key, 0) & table.bucket_mask]) & table.mask];
+        return i >= 0 && _compare_cstring(value, arg->choices[i]) ? i : -1;
+    }
+
+    /**
+     * @brief Places the largest buckets first, each with the first displacement that finds free slots for all its choices
+     *
+     * The slot table starts at 1.25 slots per choice and doubles when a bucket runs out of displacements. If that fails too
+     * (the 64 bit keys of two choices collide) the table is left empty and lookups compare linearly.
+     */
+    void _build_choice_hash(Argument* arg){
+        _choice_hash& table = arg->choice_hash;
+        std::vector<uint64_t> keys(arg->choice_count);
+        std::vector<int> unique;                // a repeated choice keeps its first index
+        for (int i=0;i<arg->choice_count;i++){
+            keys[i] = _choice_key(arg->choices[i]);
+            bool seen = false;
+            for (int k=0;k<(int)unique.size() && !seen;k++)
+                seen = keys[unique[k]] == keys[i] && arg->choices[unique[k]] == arg->choices[i];
+            if (!seen)
+                unique.push_back(i);
         }
-        if (arg->arg_type&METHOD){
+        int n = unique.size();
+        uint32_t buckets = 1;
+        while (buckets*4 < (uint32_t)n)
+            buckets <<= 1;
+        uint32_t size = 8;
+        while (size < (uint32_t)(n + n/4))
+            size <<= 1;
+
+        std::vector<std::vector<int> > members(buckets);
+        for (int k=0;k<n;k++)
+            members[_choice_mix(keys[unique[k]], 0) & (buckets-1)].push_back(unique[k]);
+        std::vector<int> order(buckets);
+        for (uint32_t b=0;b<buckets;b++)
+            order[b] = b;
+        std::sort(order.begin(), order.end(), [&members](int a, int b){ return members[a].size() > members[b].size(); });
+
+        for (int attempt=0;attempt<4;attempt++, size <<= 1){
+            table.bucket_mask = buckets-1;
+            table.mask = size-1;
+            table.displace.assign(buckets, 0);
+            table.slots.assign(size, -1);
+            bool placed = true;
+            for (uint32_t o=0;o<buckets && placed && members[order[o]].size() > 0;o++){
+                const std::vector<int>& bucket = members[order[o]];
+                placed = false;
+                for (uint32_t d=1;d<65536 && !placed;d++){
+                    int k = 0;
+                    for (;k<(int)bucket.size();k++){
+                        int32_t& slot = table.slots[_choice_mix(keys[bucket[k]], d) & table.mask];
+                        if (slot >= 0)
+                            break;
+                        slot = bucket[k];
+                    }
+                    placed = k == (int)bucket.size();
+                    if (!placed)
+                        while (k-- > 0)
+                            table.slots[_choice_mix(keys[bucket[k]], d) & table.mask] = -1;
+                    else
+                        table.displace[order[o]] = d;
+                }
+            }
+            if (placed)
+                return;
+        }
+        table.displace.clear();
+        table.slots.clear();
+    }
+
+    /**************************************************************************************************************************************
+     * DTYPES
+     *
+    */
+    /**
+     * @brief The decoded value of a typed parameter, kept per argument in the ParseResult
+     *
+     * int, duration (nanoseconds) -> integer, uint64, size (bytes), port -> uinteger, double -> real, bool -> integer 0/1,
+     * ipv4 (first 4 bytes), ipv6 -> address in network byte order
+     */
+    union _typed_value
+    {
+        long long                               integer;
+        unsigned long long                      uinteger;
+        double                                  real;
+        unsigned char                           address[16];
+    };
+
+    /**
+     * @brief from_chars style: decimal (16 digits per step) or 0x hex at str, end is set behind the last digit
+     *
+     * Does not skip whitespace, does not take a sign, ERR_WRONG_DATA without digits or on overflow
+     */
+    int _decode_u64(const char* str, unsigned long long* out, const char** end){
+        *end = str;
+        if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')){
+            if (!isxdigit((unsigned char)str[2]))
+                return ERR_WRONG_DATA;
+            char* e;
+            errno = 0;
+            *out = strtoull(str, &e, 16);
+            *end = e;
+            return errno == ERANGE ? ERR_WRONG_DATA : ERR_NO_ERR;
+        }
+        static const unsigned long long scale[17] = {1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 
+            100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 
+            100000000000000ull, 1000000000000000ull, 10000000000000000ull};
+        const _str_ops& ops = _cli_str_ops();
+        const char* p = str;
+        unsigned long long v = 0;
+        for (;;){
+            unsigned long long chunk;
+            int n = ops.digits(p, &chunk);
+            if (n == 0)
+                break;
+            if (__builtin_mul_overflow(v, scale[n], &v) || __builtin_add_overflow(v, chunk, &v))
+                return ERR_WRONG_DATA;
+            p += n;
+            if (n < 16)
+                break;
+        }
+        *end = p;
+        *out = v;
+        return p == str ? ERR_WRONG_DATA : ERR_NO_ERR;
+    }
+
+    //a signed integer ending at separator or '\0', with overflow check (one element of an int[] list)
+    int _decode_integer(const char* str, char separator, long long* out, const char** end){
+        const char* p = str;
+        bool negative = *p == '-';
+        if (*p == '-' || *p == '+')
+            p++;
+        unsigned long long v;
+        if (_decode_u64(p, &v, end) != ERR_NO_ERR || (**end != separator && **end != '\0'))
+            return ERR_WRONG_DATA;
+        if (v > (negative ? (unsigned long long)LLONG_MAX+1 : (unsigned long long)LLONG_MAX))
+            return ERR_WRONG_DATA;
+        *out = negative ? (long long)(0-v) : (long long)v;
+        return ERR_NO_ERR;
+    }
+
+    /**
+     * @brief A decimal floating point number with '.' as decimal point, whatever the current locale says
+     *
+     * Up to 19 significant digits with a power of ten within 1e22 are exact in double arithmetic and are computed
+     * right away, anything else is handed to strtod with the decimal point swapped for the locale one.
+     * end is set behind the number, ERR_WRONG_DATA without digits or when the number does not fit a double.
+     */
+    int _decode_double(const char* str, double* out, const char** end){
+        static const double scale[23] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+        const char* p = str;
+        *end = str;
+        bool negative = *p == '-';
+        if (*p == '-' || *p == '+')
+            p++;
+        if (_compare_cstring_until((char*)p, "inf", 3) || _compare_cstring_until((char*)p, "nan", 3)){
+            *out = p[0] == 'i' ? HUGE_VAL : NAN;
+            *out = negative ? -*out : *out;
+            *end = _compare_cstring_until((char*)p, "infinity", 8) ? p+8 : p+3;
+            return ERR_NO_ERR;
+        }
+        unsigned long long mantissa = 0;
+        int digits = 0;             // significant digits taken into mantissa
+        int dropped = 0;            // integer digits that did not fit
+        int exponent = 0;
+        bool any = false;
+        for (;*p >= '0' && *p <= '9';p++, any = true){
+            if (digits < 19){
+                mantissa = mantissa*10 + (*p-'0');
+                digits += mantissa != 0;
+            }else
+                dropped++;
+        }
+        if (*p == '.'){
+            for (p++;*p >= '0' && *p <= '9';p++, any = true){
+                if (digits < 19){
+                    mantissa = mantissa*10 + (*p-'0');
+                    digits += mantissa != 0;
+                    exponent--;
+                }else
+                    dropped++;
+            }
+        }
+        if (!any)
+            return ERR_WRONG_DATA;
+        if ((*p == 'e' || *p == 'E') && ((p[1] >= '0' && p[1] <= '9') || ((p[1] == '-' || p[1] == '+') && p[2] >= '0' && p[2] <= '9'))){
+            p++;
+            bool negative_exponent = *p == '-';
+            if (*p == '-' || *p == '+')
+                p++;
+            int e = 0;
+            for (;*p >= '0' && *p <= '9';p++)
+                e = e < 100000 ? e*10 + (*p-'0') : e;
+            exponent += negative_exponent ? -e : e;
+        }
+        *end = p;
+        if (dropped == 0 && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22){
+            double value = (double)mantissa;
+            value = exponent < 0 ? value / scale[-exponent] : value * scale[exponent];
+            *out = negative ? -value : value;
+            return ERR_NO_ERR;
+        }
+        char local[128];
+        int l = p-str;
+        std::string heap;
+        char* copy = local;
+        if (l >= (int)sizeof(local)){
+            heap.assign(str, l);
+            copy = &heap[0];
+        }else
+            memcpy(copy, str, l);
+        copy[l] = '\0';
+        for (int i=0;i<l;i++)
+            if (copy[i] == '.')
+                copy[i] = localeconv()->decimal_point[0];
+        errno = 0;
+        *out = strtod(copy, nullptr);
+        return errno == ERANGE && (*out == HUGE_VAL || *out == -HUGE_VAL) ? ERR_WRONG_DATA : ERR_NO_ERR;
+    }
+
+    //a byte count with an optional binary suffix: 512, 4K, 16KiB, 1.5 is rejected, 8GB = 8*2^30
+    int _decode_size(const char* str, unsigned long long* out){
+        const char* p;
+        unsigned long long v;
+        if (_decode_u64(str, &v, &p) != ERR_NO_ERR)
+            return ERR_WRONG_DATA;
+        const char* units = "KMGTPE";
+        int shift = 0;
+        for (int i=0;units[i] != '\0';i++)
+            if ((*p & ~0x20) == units[i])
+                shift = 10*(i+1);
+        if (shift > 0){
+            p++;
+            if (*p == 'i')
+                p++;
+        }
+        if ((*p & ~0x20) == 'B')
+            p++;
+        if (*p != '\0' || (shift > 0 && v > (~0ull >> shift)))
+            return ERR_WRONG_DATA;
+        *out = v << shift;
+        return ERR_NO_ERR;
+    }
+
+    //a duration in nanoseconds, one or more number+unit parts (ns, us, ms, s, m, h, d): 250ms, 1h30m, a bare number is seconds
+    int _decode_duration(const char* str, long long* out){
+        static const char* units[] = {"ns", "us", "ms", "s", "m", "h", "d"};
+        static const unsigned long long ns[] = {1ull, 1000ull, 1000000ull, 1000000000ull, 60000000000ull, 3600000000000ull, 86400000000000ull};
+        const char* p = str;
+        unsigned long long total = 0;
+        int parts = 0;
+        while (*p != '\0'){
+            unsigned long long v;
+            if (_decode_u64(p, &v, &p) != ERR_NO_ERR)
+                return ERR_WRONG_DATA;
+            int unit = -1;
+            for (int i=0;i<7 && unit < 0;i++){
+                int l = strlen(units[i])-1;
+                if (_compare_cstring_until((char*)p, (char*)units[i], l) && !(p[l] >= 'a' && p[l] <= 'z'))
+                    unit = i;
+            }
+            if (unit < 0 && !(*p == '\0' && parts == 0))
+                return ERR_WRONG_DATA;
+            if (__builtin_mul_overflow(v, ns[unit < 0 ? 3 : unit], &v) || __builtin_add_overflow(total, v, &total))
+                return ERR_WRONG_DATA;
+            p += unit < 0 ? 0 : strlen(units[unit])-1;
+            parts++;
+        }
+        if (parts == 0 || total > (unsigned long long)LLONG_MAX)
+            return ERR_WRONG_DATA;
+        *out = (long long)total;
+        return ERR_NO_ERR;
+    }
+
+    /**
+     * @brief Validates value against a built-in dtype and decodes it into out
+     *
+     * ERR_NO_ERR, ERR_WRONG_DATA, or ERR_NOT_FOUND for dtypes without a typed value (string, file, url, lists)
+     */
+    int _decode_typed(int dtype, const char* value, _typed_value* out){
+        const char* end;
+        switch (dtype){
+            case CLI_DTYPE_INT:{
+                char* e;
+                errno = 0;
+                out->integer = strtoll(value, &e, 0);
+                return e == value || *e != '\0' || errno == ERANGE ? ERR_WRONG_DATA : ERR_NO_ERR;
+            }
+            case CLI_DTYPE_DOUBLE:
+                return _decode_double(value, &out->real, &end) == ERR_NO_ERR && *end == '\0' ? ERR_NO_ERR : ERR_WRONG_DATA;
+            case CLI_DTYPE_BOOL:{
+                bool on;
+                if (_decode_bool(value, &on) != ERR_NO_ERR)
+                    return ERR_WRONG_DATA;
+                out->integer = on;
+                return ERR_NO_ERR;
+            }
+            case CLI_DTYPE_UINT64:
+                return _decode_u64(value, &out->uinteger, &end) == ERR_NO_ERR && *end == '\0' ? ERR_NO_ERR : ERR_WRONG_DATA;
+            case CLI_DTYPE_SIZE:
+                return _decode_size(value, &out->uinteger);
+            case CLI_DTYPE_DURATION:
+                return _decode_duration(value, &out->integer);
+            case CLI_DTYPE_PORT:
+                return _decode_u64(value, &out->uinteger, &end) == ERR_NO_ERR && *end == '\0' && out->uinteger <= 65535 ? ERR_NO_ERR : ERR_WRONG_DATA;
+            case CLI_DTYPE_IPV4:
+                memset(out->address, 0, 16);
+                return inet_pton(AF_INET, value, out->address) == 1 ? ERR_NO_ERR : ERR_WRONG_DATA;
+            case CLI_DTYPE_IPV6:
+                return inet_pton(AF_INET6, value, out->address) == 1 ? ERR_NO_ERR : ERR_WRONG_DATA;
+        }
+        return ERR_NOT_FOUND;
+    }
+
+    /**
+     * @brief The decoded value in the plain decimal form the bindings read, nullptr if the text itself is passed on
+     *
+     * So a "duration" parameter bound to a long long receives nanoseconds and a "size" bound to a size_t receives bytes.
+     */
+    const char* _typed_text(int dtype, const _typed_value& value, char* buffer, int size){
+        switch (dtype){
+            case CLI_DTYPE_DOUBLE:
+                snprintf(buffer, size, "%.17g", value.real);
+                return buffer;
+            case CLI_DTYPE_BOOL:
+            case CLI_DTYPE_DURATION:
+                snprintf(buffer, size, "%lld", value.integer);
+                return buffer;
+            case CLI_DTYPE_UINT64:
+            case CLI_DTYPE_SIZE:
+            case CLI_DTYPE_PORT:
+                snprintf(buffer, size, "%llu", value.uinteger);
+                return buffer;
+        }
+        return nullptr;
+    }
+
+    //(x - base) / step is not a whole number, allowing the rounding of the subtraction and the division
+    bool _off_step(double x, double base, double step){
+        double q = (x-base)/step;
+        double tolerance = 4*DBL_EPSILON*(fabs(q) + (fabs(x)+fabs(base))/fabs(step));
+        return !(fabs(q-nearbyint(q)) <= tolerance);
+    }
+
+    //x - base is not a multiple of step, in unsigned arithmetic so the distance cannot overflow
+    bool _off_step(unsigned long long x, unsigned long long base, unsigned long long step, bool is_signed){
+        bool below = is_signed ? (long long)x < (long long)base : x < base;
+        unsigned long long distance = below ? base-x : x-base;
+        if (is_signed && (long long)step < 0)
+            step = 0-step;
+        return distance % step != 0;
+    }
+
+    /**
+     * @brief The first constraint the decoded value violates (CLI_CHECK_*), 0 if it passes
+     *
+     * All enabled checks are evaluated into one mask without branching per check.
+     */
+    int _check_constraint(const _constraint& c, int dtype, const _typed_value& v){
+        if (c.checks == 0)
+            return 0;
+        int failed = 0;
+        switch (_dtype_kind(dtype)){
+            case 1:{
+                long long x = v.integer;
+                long long base = c.checks&CLI_CHECK_MIN ? c.min.integer : 0;
+                failed = (x < c.min.integer)*CLI_CHECK_MIN | (x > c.max.integer)*CLI_CHECK_MAX | 
+                         (c.step.integer != 0 && _off_step(x, base, c.step.integer, true))*CLI_CHECK_STEP | (x <= 0 || (x & (x-1)) != 0)*CLI_CHECK_POW2;
+                break;
+            }
+            case 2:{
+                unsigned long long x = v.uinteger;
+                unsigned long long base = c.checks&CLI_CHECK_MIN ? c.min.uinteger : 0;
+                failed = (x < c.min.uinteger)*CLI_CHECK_MIN | (x > c.max.uinteger)*CLI_CHECK_MAX | 
+                         (c.step.uinteger != 0 && _off_step(x, base, c.step.uinteger, false))*CLI_CHECK_STEP | (x == 0 || (x & (x-1)) != 0)*CLI_CHECK_POW2;
+                break;
+            }
+            case 3:{
+                double x = v.real;
+                double base = c.checks&CLI_CHECK_MIN ? c.min.real : 0;
+                failed = !(x >= c.min.real)*CLI_CHECK_MIN | !(x <= c.max.real)*CLI_CHECK_MAX | 
+                         (c.step.real != 0 && _off_step(x, base, c.step.real))*CLI_CHECK_STEP;
+                break;
+            }
+        }
+        failed &= c.checks;
+        return failed & -failed;
+    }
+
+     /**
+     * @brief THE ARGPRASE FUNCTION
+     * 
+     * Can also be used to sanity check arguments vs the argv input
+     * 
+     */
+    int parseArg(Argument* arg, char* thearg){
+
+
+        if (arg->arg_type&(OPTION | WILDCARD) && thearg[0] == '-'){
+            if (thearg[1] == '-' && _compare_cstring(thearg+2, arg->long_flag))
+                return ERR_NO_ERR;
+            if (_compare_cstring(thearg+1, arg->short_flag))
+                return ERR_NO_ERR;
+        }
+        if (arg->arg_type&METHOD){
             if (_compare_cstring(thearg,arg->long_flag) || 
                 _compare_cstring(thearg,arg->short_flag))
             return ERR_NO_ERR;
@@ -555,43 +1898,51 @@ namespace cli
 
             
 
-            if (_compare_cstring_until(thearg, "-", 1) || _compare_cstring_until(thearg, "--", 2)){
+            if (thearg[0] == '-' && !_negative_value(arg->dtype, thearg)){
                 return ERR_REQ_PARAM_NOT_FOUND | ERR_INVALID_INPUT | ERR_WRONG_DATA; //probably attached another option instead of an paramter
             }
 
+            if (arg->choice_count > 0 && _choice_index(arg, thearg) < 0)
+                return ERR_WRONG_DATA;
             if (arg->is_custom_dtype){
                 return arg->dtype_check_cb(thearg);
             }
-            if (_compare_cstring(arg->dtype_custom, "string")){
-                return strlen(thearg)>0 ? ERR_NO_ERR : ERR_WRONG_DATA;
-            }
-            if (_compare_cstring(arg->dtype_custom, "int")){
-                char* end;
-                long number = strtol(thearg, &end, 0);
-                if (*end == '\0')
-                    return ERR_NO_ERR;
-                else
-                    return arg->required?ERR_WRONG_DATA | ERR_REQ_PARAM_NOT_FOUND:ERR_WRONG_DATA;
-                
-            }
-            if (_compare_cstring(arg->dtype_custom, "file")){
-                if (access(thearg, F_OK) == 0) {
-                    return ERR_NO_ERR;
-                } else {
-                    return ERR_WRONG_DATA;
+            switch (arg->dtype){
+                case CLI_DTYPE_STRING:
+                    return thearg[0] != '\0' ? ERR_NO_ERR : ERR_WRONG_DATA;
+                case CLI_DTYPE_INT:{
+                    _typed_value number;
+                    if (_decode_typed(CLI_DTYPE_INT, thearg, &number) == ERR_NO_ERR)
+                        return ERR_NO_ERR;
+                    else
+                        return arg->required?ERR_WRONG_DATA | ERR_REQ_PARAM_NOT_FOUND:ERR_WRONG_DATA;
                 }
-            }
-            if (_compare_cstring(arg->dtype_custom, "url")){
-                if (_compare_cstring_until(thearg, "http", 4))
-                    return ERR_NO_ERR;
-                return 0;
-            }
-            if (_compare_cstring(arg->dtype_custom, "file")){
-                    //TODO
-                    return 1;
-            }
-            if (arg->dtype_check_cb != nullptr){
-                arg->dtype_check_cb(thearg);
+                case CLI_DTYPE_DOUBLE:
+                case CLI_DTYPE_BOOL:
+                case CLI_DTYPE_UINT64:
+                case CLI_DTYPE_SIZE:
+                case CLI_DTYPE_DURATION:
+                case CLI_DTYPE_IPV4:
+                case CLI_DTYPE_IPV6:
+                case CLI_DTYPE_PORT:{
+                    _typed_value value;
+                    return _decode_typed(arg->dtype, thearg, &value);
+                }
+                case CLI_DTYPE_FILE:
+                    if (access(thearg, F_OK) == 0) {
+                        return ERR_NO_ERR;
+                    } else {
+                        return ERR_WRONG_DATA;
+                    }
+                case CLI_DTYPE_URL:
+                    if (_compare_cstring_until(thearg, "http", 4))
+                        return ERR_NO_ERR;
+                    return 0;
+                //the elements are checked while ListValues decodes them
+                case CLI_DTYPE_INT_LIST:
+                case CLI_DTYPE_DOUBLE_LIST:
+                case CLI_DTYPE_STRING_LIST:
+                    return thearg[0] != '\0' ? ERR_NO_ERR : ERR_WRONG_DATA;
             }
         }
         return arg->required?ERR_REQ_ARG_NOT_FOUND:ERR_NOT_FOUND;
@@ -603,89 +1954,1720 @@ namespace cli
                           char *long_flag,
                           bool required,
                           char *help);
+    /**
+     * @brief The matching relevant part of an Argument, compiled by argument_tree::finalize()
+     *
+     * 24 bytes instead of the whole Argument, so the flag matching loop only walks a dense array of these and
+     * touches the cold Argument (help, choices, callbacks, flag strings) only for a hash hit.
+     * The children of every record are contiguous, the children of the root come first.
+     */
+    struct _hot_arg
+    {
+        uint32_t                                long_hash;      // hash of the long flag, for methods their bare name
+        uint32_t                                short_hash;
+        int32_t                                 id;             // Argument::id, the cold side is argument_tree::by_id[id]
+        int32_t                                 parent;         // hot index of the enclosing scope, -1 for the root
+        int32_t                                 child_begin;    // hot index of the first child
+        uint16_t                                child_count;
+        uint8_t                                 type_bits;      // ArgumentType | repeat policy << _HOT_REPEAT_SHIFT | _HOT_REQUIRED
+        int8_t                                  dtype;          // CLI_DTYPE_*
+    };
+
+#define _HOT_REQUIRED 0x80
+#define _HOT_REPEAT_SHIFT 5
+#define _HOT_REPEAT(type_bits) (((type_bits) >> _HOT_REPEAT_SHIFT) & 3)
+
+    //bumped by setters that change the compiled schema of an already registered argument
+    unsigned int& _schema_stamp(){
+        static unsigned int stamp = 0;
+        return stamp;
+    }
+
     /**
      * @brief Here are hidden implementations, that should not be exposed to the outside
      * Hidden Namespace with state and container variables
      * 
      */
-    namespace
+    /**************************************************************************************************************************************
+     * ENVIRONMENT
+     *
+    */
+    /**
+     * @brief Open addressing index over the declared environment variable names of one CommandLine
+     *
+     * Built per parse from the arguments carrying an env_name, then environ is scanned exactly once and
+     * every entry is probed against the index, instead of one linear getenv() scan per argument.
+     */
+    struct _env_index
     {
-        struct argument_tree
-        {
-            Argument *root;
-            int size;
-            int methods;
-            int options;
-            int* verbosity;
+        std::vector<Argument*>                  slots;  // power of two sized, nullptr = empty
+        unsigned int                            mask;
+
+        static unsigned int hash(const char* str){
+            unsigned int h = 2166136261u;
+            for (int i=0;str[i] != '\0' && str[i] != '=';i++)
+                h = (h ^ (unsigned char)str[i]) * 16777619u;
+            return h;
+        }
 
-            argument_tree(int* cli_verbosity);
-            int addArgument(Argument* arg);
-        };
+        static unsigned int sizeFor(int count){
+            unsigned int size = 8;
+            while (size < (unsigned int)count*2)
+                size <<= 1;
+            return size;
+        }
 
+        void reserve(int count){
+            this->slots.reserve(sizeFor(count));
+        }
 
-        struct map_node
-        {
-            map_node();
+        void build(std::vector<Argument*>& declared){
+            unsigned int size = sizeFor(declared.size());
+            this->slots.assign(size, nullptr);
+            this->mask = size-1;
+            for (int i=0;i<(int)declared.size();i++){
+                unsigned int h = hash(declared[i]->env_name) & this->mask;
+                while (this->slots[h] != nullptr)
+                    h = (h+1) & this->mask;
+                this->slots[h] = declared[i];
+            }
+        }
+
+        //resolves env_value of every declared argument, the last duplicate name wins like with getenv
+        void scan(char** env){
+            if (env == nullptr)
+                return;
+            for (int e=0;env[e] != nullptr;e++){
+                char* entry = env[e];
+                int l = 0;
+                while (entry[l] != '=' && entry[l] != '\0')
+                    l++;
+                if (entry[l] != '=')
+                    continue;
+                for (unsigned int h = hash(entry) & this->mask;this->slots[h] != nullptr;h = (h+1) & this->mask){
+                    Argument* arg = this->slots[h];
+                    int k = 0;
+                    while (k < l && arg->env_name[k] == entry[k])
+                        k++;
+                    if (k == l && arg->env_name[l] == '\0')
+                        arg->env_value = entry+l+1;
+                }
+            }
+        }
+    };
+
+    //collects the arguments below arg declaring an environment variable and clears their last resolved value
+    //declared has to have room for every argument below arg, it is never grown here
+    void _collect_env(Argument* arg, std::vector<Argument*>* declared){
+        for (int i=0;i<(int)arg->arguments.size();i++){
+            Argument* child = arg->arguments[i];
+            child->env_value = nullptr;
+            if (child->env_name != nullptr)
+                declared->push_back(child);
+            _collect_env(child, declared);
+        }
+    }
+
+    /**
+     * @brief One problem found by the parser, plain integers and a pointer into argv or environ, formatted only on
+     * request by CommandLine::describe()
+     */
+    struct Diagnostic
+    {
+        int                                     kind;           // the ERR_* bit(s) it caused
+        int                                     argv_index;     // the token it is about, -1 for the environment or an absent argument
+        int                                     offset;         // byte offset into that token, the failing element of a list
+        int                                     id;             // Argument::id, -1 for a token that matched nothing
+        int                                     detail;         // CLI_CHECK_* for ERR_OUT_OF_RANGE, CLI_RULE_* for rule violations
+        int                                     other;          // the second id of a rule, the rules index for CLI_RULE_ONE_OF
+        const char*                             text;           // the offending value or token, nullptr if there is none
+    };
+
+    //a rule between arguments as declared, compiled into bitmasks by argument_tree::finalize()
+    struct _rule
+    {
+        int                                     kind;           // CLI_RULE_*
+        std::vector<Argument*>                  members;        // CLI_RULE_REQUIRES: members[0] requires all others
+    };
+
+    struct argument_tree
+    {
+        Argument *root;
+        int size;
+        int methods;
+        int options;
+        int* verbosity;
+        std::vector<Argument*> by_id;   //every registered argument below root, indexed by Argument::id, the cold side table
+        std::vector<_hot_arg> hot;      //compiled by finalize(), the root children are hot[0, root_count)
+        int root_count;
+        bool dirty;                     //the schema changed since the last finalize()
+        int version;                    //bumped whenever the schema changes
+        unsigned int stamp;             //_schema_stamp() at the last finalize()
+        std::vector<Argument*> env_declared;    //reserved by finalize() for all arguments, filled per parse
+        _env_index env_index;
+        _help_store help_texts;                 //help messages of the arguments, moved in and compressed by finalize()
+
+        std::vector<_rule> rules;
+        int words;                              //64 bit words per mask below, as in the ParseResult present bitset
+        std::vector<uint64_t> constrained;      //ids that exclude or require something
+        std::vector<uint64_t> excluded_by;      //words per id, the ids that must be absent when it is present
+        std::vector<uint64_t> required_by;      //words per id, the ids that must be present when it is present
+        std::vector<uint64_t> one_of;           //words per CLI_RULE_ONE_OF rule, at least one must be present
+        std::vector<int> one_of_rule;           //index into rules per one_of mask
+
+        std::vector<uint64_t> required;         //words, every required argument or parameter
+        std::vector<int> parent_id;             //per id, the id of the enclosing argument, -1 below the root
+        int list_params;                        //parameters of a list dtype
+        int list_dtypes;                        //1 << dtype of each list dtype in use, 0 skips the ListValues pass
+
+        void compileRules();
+        int checkRules(const uint64_t* present, Diagnostic* found, int capacity, int* count) const;
+
+        argument_tree(int* cli_verbosity);
+        int addArgument(Argument* arg);
+        void assignIds(Argument* arg);
+        void finalize();
+    };
+
+
+    struct map_node
+    {
+        map_node();
+    };
+
+    /**
+     * @brief Internal Datastructure to capture and hold parsed values and display them as
+     *
+     */
+    struct map
+    {
+        map(){
+             if (CommandLineVerbosity>=VERBOSE_FULL){
+      
+                std::cout << _get_verbosity_msg(2);
+            }
         };
 
-        /**
-         * @brief Internal Datastructure to capture and hold parsed values and display them as
-         *
-         */
-        struct map
+        template <typename dtype>
+        std::vector<dtype> operator[](const char *key)
         {
-            map(){
-                 if (CommandLineVerbosity>=VERBOSE_FULL){
+            // check for key, if not parsed, return error method and help menu
+            // if node present, check the datatype of the "wanted" dtype and the currently available "dtype"
+            return std::vector<dtype>();
+        };
+    };
+
+
+    argument_tree::argument_tree(int* cli_verbosity){
+        this->verbosity = cli_verbosity;
+        this->root = new Argument(
+            _NULL_ARG_,
+            "r",
+            "root",
+            true,
+            "The root argument of the argument tree");
+        this->methods = 0;
+        this->options = 0;
+        this->size = 0;
+        this->by_id = std::vector<Argument*>();
+        this->hot = std::vector<_hot_arg>();
+        this->root_count = 0;
+        this->dirty = true;
+        this->version = 0;
+        this->stamp = 0;
+        this->words = 0;
+        this->list_params = 0;
+        this->list_dtypes = 0;
+
+
+        if (CommandLineVerbosity>=VERBOSE_FULL){
+            std::cout << _get_verbosity_msg(1);
+        }
+    };
+
+
+
+    int argument_tree::addArgument(Argument* arg){
+        if (CommandLineVerbosity>=VERBOSE_FULL){
+            std::cout << _get_verbosity_msg(3);
+        }
           
-                    std::cout << _get_verbosity_msg(2);
+        this->methods += (arg->getArgType()&METHOD) > 0;
+        this->options += (arg->getArgType()&OPTION) > 0;
+    
+        this->root->addArgument(arg);
+        this->assignIds(this->root);
+        return ERR_NO_ERR;
+    };
+
+    //hands out dense ids to all arguments below arg that do not have one yet (also parameters added later on)
+    void argument_tree::assignIds(Argument* arg){
+        for (int i=0;i<(int)arg->arguments.size();i++){
+            Argument* child = arg->arguments[i];
+            if (child->id < 0){
+                child->id = this->size++;
+                this->by_id.push_back(child);
+                this->dirty = true;
+                this->version++;
+            }
+            this->assignIds(child);
+        }
+    };
+
+    //compiles the hot records breadth first, so the children of every scope end up next to each other
+    void argument_tree::finalize(){
+        this->assignIds(this->root);
+        if (this->stamp != _schema_stamp()){
+            this->stamp = _schema_stamp();
+            this->dirty = true;
+            this->version++;
+        }
+        if (!this->dirty)
+            return;
+        std::vector<Argument*> order(this->root->arguments);
+        std::vector<int> parents(order.size(), -1);
+        this->hot.assign(order.size(), _hot_arg());
+        this->root_count = order.size();
+        for (int h=0;h<(int)order.size();h++){
+            Argument* arg = order[h];
+            _hot_arg rec;
+            rec.long_hash   = _hash_flag(arg->long_flag);
+            rec.short_hash  = _hash_flag(arg->short_flag);
+            rec.id          = arg->id;
+            rec.parent      = parents[h];
+            rec.child_begin = order.size();
+            rec.child_count = arg->arguments.size();
+            int repeat      = arg->repeat;
+            if (repeat == CLI_REPEAT_APPEND && arg->arg_type&PARAM && parents[h] >= 0)
+                repeat = _HOT_REPEAT(this->hot[parents[h]].type_bits);
+            rec.type_bits   = (arg->arg_type & 0x1F) | (repeat << _HOT_REPEAT_SHIFT) | (arg->required ? _HOT_REQUIRED : 0);
+            rec.dtype       = arg->dtype;
+            this->hot[h] = rec;
+            for (int c=0;c<(int)arg->arguments.size();c++){
+                order.push_back(arg->arguments[c]);
+                parents.push_back(h);
+                this->hot.push_back(_hot_arg());
+            }
+        }
+        for (int id=0;id<(int)this->by_id.size();id++)
+            if (this->by_id[id]->choice_count > 0)
+                _build_choice_hash(this->by_id[id]);
+        this->compileRules();
+        //help texts added since the last schema build move into the store and are compressed now
+        for (int id=0;id<(int)this->by_id.size();id++){
+            Argument* arg = this->by_id[id];
+            if (arg->help_msg == nullptr || arg->help_ref >= 0)
+                continue;
+            arg->help_ref = this->help_texts.add(arg->help_msg);
+            delete[] arg->help_msg;
+            arg->help_msg = nullptr;
+        }
+        this->help_texts.pack();
+        this->required.assign(this->words, 0);
+        this->parent_id.assign(this->by_id.size(), -1);
+        this->list_params = 0;
+        this->list_dtypes = 0;
+        for (int id=0;id<(int)this->by_id.size();id++){
+            Argument* arg = this->by_id[id];
+            if (arg->arg_type&PARAM && arg->dtype >= CLI_DTYPE_INT_LIST && arg->dtype <= CLI_DTYPE_STRING_LIST){
+                this->list_params++;
+                this->list_dtypes |= 1 << arg->dtype;
+            }
+            if (arg->required)
+                this->required[id>>6] |= (uint64_t)1 << (id&63);
+            if (arg->parent != nullptr && arg->parent != this->root)
+                this->parent_id[id] = arg->parent->id;
+        }
+        //room for a per parse environment lookup that never has to grow
+        this->env_declared.reserve(this->by_id.size());
+        this->env_index.reserve(this->by_id.size());
+        this->dirty = false;
+    };
+
+    //the rules as masks over the dense ids, arguments that are not registered yet are left out
+    void argument_tree::compileRules(){
+        int count = this->by_id.size();
+        int words = (count+63)/64;
+        this->words = words;
+        this->constrained.assign(words, 0);
+        this->excluded_by.assign(count*words, 0);
+        this->required_by.assign(count*words, 0);
+        this->one_of.clear();
+        this->one_of_rule.clear();
+
+        //Argument::addExclude() names become pairwise exclusive rules
+        std::vector<_rule> rules(this->rules);
+        for (int id=0;id<count;id++){
+            Argument* arg = this->by_id[id];
+            for (int e=0;e<arg->exclude_count;e++)
+                for (int other=0;other<count;other++)
+                    if (this->by_id[other]->long_flag == arg->excludes[e] && other != id){
+                        _rule rule;
+                        rule.kind = CLI_RULE_EXCLUSIVE;
+                        rule.members.push_back(arg);
+                        rule.members.push_back(this->by_id[other]);
+                        rules.push_back(rule);
+                    }
+        }
+
+        for (int r=0;r<(int)rules.size();r++){
+            const std::vector<Argument*>& members = rules[r].members;
+            std::vector<int> ids;
+            for (int m=0;m<(int)members.size();m++)
+                ids.push_back(members[m]->id >= 0 && members[m]->id < count ? members[m]->id : -1);
+            if (rules[r].kind == CLI_RULE_EXCLUSIVE){
+                for (int i=0;i<(int)ids.size();i++)
+                    for (int k=0;k<(int)ids.size();k++)
+                        if (ids[i] >= 0 && ids[k] >= 0 && ids[i] != ids[k]){
+                            this->excluded_by[ids[i]*words + (ids[k]>>6)] |= (uint64_t)1 << (ids[k]&63);
+                            this->constrained[ids[i]>>6] |= (uint64_t)1 << (ids[i]&63);
+                        }
+            }else if (rules[r].kind == CLI_RULE_REQUIRES){
+                if (ids.size() == 0 || ids[0] < 0)
+                    continue;
+                for (int k=1;k<(int)ids.size();k++)
+                    if (ids[k] >= 0){
+                        this->required_by[ids[0]*words + (ids[k]>>6)] |= (uint64_t)1 << (ids[k]&63);
+                        this->constrained[ids[0]>>6] |= (uint64_t)1 << (ids[0]&63);
+                    }
+            }else if (r < (int)this->rules.size()){
+                this->one_of.resize(this->one_of.size()+words, 0);
+                uint64_t* mask = &this->one_of[this->one_of.size()-words];
+                for (int k=0;k<(int)ids.size();k++)
+                    if (ids[k] >= 0)
+                        mask[ids[k]>>6] |= (uint64_t)1 << (ids[k]&63);
+                this->one_of_rule.push_back(r);
+            }
+        }
+    };
+
+    /**
+     * @brief Checks all rules against the present bitset of a parse
+     *
+     * Only ids that are present and constrained are looked at, each with one AND per word against its exclusion and
+     * requirement masks, plus one AND per word for every at least one group. Every violation is appended to found
+     * while there is room (count keeps counting past capacity): detail is the CLI_RULE_*, id and other the offending
+     * ids, for CLI_RULE_ONE_OF id is -1 and other the index into rules. A conflict is reported once, by the lower id.
+     */
+    int argument_tree::checkRules(const uint64_t* present, Diagnostic* found, int capacity, int* count) const{
+        int words = this->words;
+        int err = ERR_NO_ERR;
+        for (int w=0;w<words;w++){
+            for (uint64_t todo = present[w] & this->constrained[w];todo != 0;todo &= todo-1){
+                int id = w*64 + __builtin_ctzll(todo);
+                const uint64_t* excluded = &this->excluded_by[id*words];
+                const uint64_t* required = &this->required_by[id*words];
+                for (int k=0;k<words;k++){
+                    uint64_t clash = excluded[k] & present[k];
+                    uint64_t missing = required[k] & ~present[k];
+                    if (k == w)
+                        clash &= ~(((uint64_t)2 << (id&63)) - 1);
+                    else if (k < w)
+                        clash = 0;
+                    for (uint64_t bits = clash | missing;bits != 0;bits &= bits-1){
+                        uint64_t bit = bits & (0-bits);
+                        int kind = clash & bit ? ERR_CONFLICT : ERR_DEPENDENCY;
+                        err |= kind;
+                        if (*count < capacity){
+                            Diagnostic d = {kind, -1, 0, id, kind == ERR_CONFLICT ? CLI_RULE_EXCLUSIVE : CLI_RULE_REQUIRES, 
+                                            k*64 + __builtin_ctzll(bit), nullptr};
+                            found[*count] = d;
+                        }
+                        (*count)++;
+                    }
                 }
-            };
+            }
+        }
+        for (int g=0;g<(int)this->one_of_rule.size();g++){
+            uint64_t any = 0;
+            for (int k=0;k<words;k++)
+                any |= this->one_of[g*words + k] & present[k];
+            if (any != 0)
+                continue;
+            err |= ERR_DEPENDENCY;
+            if (*count < capacity){
+                Diagnostic d = {ERR_DEPENDENCY, -1, 0, -1, CLI_RULE_ONE_OF, this->one_of_rule[g], nullptr};
+                found[*count] = d;
+            }
+            (*count)++;
+        }
+        return err;
+    };
 
-            template <typename dtype>
-            std::vector<dtype> operator[](const char *key)
-            {
-                // check for key, if not parsed, return error method and help menu
-                // if node present, check the datatype of the "wanted" dtype and the currently available "dtype"
-                return std::vector<dtype>();
-            };
-        };
 
+   
+
+    /**************************************************************************************************************************************
+     * CONFIG
+     *
+    */
+    /**
+     * @brief One merged configuration value
+     */
+    struct ConfigEntry
+    {
+        const char*                             value;      // nullptr when no layer provided one
+        long long                               integer;    // decoded for numeric parameters, the choice index for choices, 1 for present flags
+        double                                  real;       // decoded for numeric parameters
+        int                                     source;     // CLI_SOURCE_*
+    };
+
+    /**
+     * @brief The effective configuration, merged from defaults < config file < environment < argv
+     *
+     * Flat and indexed by Argument::id, so reading a value is an array access instead of an Options::get walk.
+     * Owns the config file contents, the values of the other layers point into argv, environ or the schema.
+     */
+    struct Config
+    {
+        std::vector<ConfigEntry>                entries;
+        std::vector<const char*>                unknown;    // config file keys that name no argument, reported here instead of failing the merge
+        char*                                   file_data;
 
-        argument_tree::argument_tree(int* cli_verbosity){
-            this->verbosity = cli_verbosity;
-            this->root = new Argument(
-                _NULL_ARG_,
-                "r",
-                "root",
-                true,
-                "The root argument of the argument tree");
-            this->methods = 0;
-            this->options = 0;
+        Config(){
+            this->file_data = nullptr;
+        };
+        ~Config(){
+            free(this->file_data);
+        };
+        Config(const Config&) = delete;
+        Config& operator=(const Config&) = delete;
 
+        int size() const{
+            return this->entries.size();
+        };
+        const ConfigEntry& operator[](int id) const{
+            return this->entries[id];
+        };
+        const ConfigEntry& get(const Argument* arg) const{
+            return this->entries[arg->id];
+        };
+        const char* value(const Argument* arg) const{
+            return this->entries[arg->id].value;
+        };
+        long long integer(const Argument* arg) const{
+            return this->entries[arg->id].integer;
+        };
+        double real(const Argument* arg) const{
+            return this->entries[arg->id].real;
+        };
+        int source(const Argument* arg) const{
+            return this->entries[arg->id].source;
+        };
+    };
 
-            if (CommandLineVerbosity>=VERBOSE_FULL){
-                std::cout << _get_verbosity_msg(1);
+    /**************************************************************************************************************************************
+     * PARSE RESULT
+     *
+    */
+    /**
+     * @brief The flat result of one parse, indexed by the dense Argument::id
+     *
+     * Everything lives in a single block of plain integers and pointers into argv/environ:
+     *
+     *      present[words] | missing[words] | values[slots] | env[count] | typed[count] | occurrences[count] |
+     *      value_offset[count] | value_count[count] | choice_ids[count] | owner[argc] | value_argv[slots] | source[count]
+     *
+     * "is flag X set" is one bit test, the values of an argument are contiguous (values[value_offset[id] ...]),
+     * owner maps each argv index to the argument that consumed it, and copying a result is one memcpy.
+     * Flags record their own token as value, so for them value_count equals the occurrences.
+     * Problems are kept next to the block in a fixed diagnostics array, nothing is formatted while parsing.
+     */
+    struct ParseResult
+    {
+        char*                                   block;
+        int                                     capacity;       // usable bytes of block
+        bool                                    owned;          // false for caller provided storage (attach)
+        int                                     bytes;
+        int                                     count;          // argument ids
+        int                                     words;          // 64 bit words of the present bitset
+        int                                     argc;
+        int                                     slots;          // value slots, argc for argv tokens + count for environment values
+        Diagnostic                              diagnostics[CLI_MAX_DIAGNOSTICS];  // the first problems in the order they were found
+        int                                     diagnostic_count;                  // every problem found, can exceed CLI_MAX_DIAGNOSTICS
+
+        ParseResult(){
+            this->block = nullptr;
+            this->capacity = 0;
+            this->owned = true;
+            this->bytes = 0;
+            this->count = 0;
+            this->words = 0;
+            this->argc = 0;
+            this->slots = 0;
+            this->diagnostic_count = 0;
+        };
+        ParseResult(const ParseResult& other) : ParseResult(){
+            *this = other;
+        };
+        //takes the block of other (and its ownership), other is left empty
+        ParseResult(ParseResult&& other) : ParseResult(){
+            *this = std::move(other);
+        };
+        //copies into the block of this result, an attached one that is too small for other is switched to an owned
+        //heap block (unlike reset(), which never leaves caller storage), attach() again to get back to the storage
+        ParseResult& operator=(const ParseResult& other){
+            if (this == &other)
+                return *this;
+            if (this->capacity < other.bytes){
+                if (this->owned)
+                    free(this->block);
+                this->block = (char*)malloc(other.bytes);
+                this->capacity = other.bytes;
+                this->owned = true;
             }
+            if (other.bytes > 0)
+                memcpy(this->block, other.block, other.bytes);
+            this->bytes = other.bytes;
+            this->count = other.count;
+            this->words = other.words;
+            this->argc = other.argc;
+            this->slots = other.slots;
+            this->diagnostic_count = other.diagnostic_count;
+            memcpy(this->diagnostics, other.diagnostics, sizeof(this->diagnostics));
+            return *this;
+        };
+        ParseResult& operator=(ParseResult&& other){
+            if (this == &other)
+                return *this;
+            if (this->owned)
+                free(this->block);
+            this->block = other.block;
+            this->capacity = other.capacity;
+            this->owned = other.owned;
+            this->bytes = other.bytes;
+            this->count = other.count;
+            this->words = other.words;
+            this->argc = other.argc;
+            this->slots = other.slots;
+            this->diagnostic_count = other.diagnostic_count;
+            memcpy(this->diagnostics, other.diagnostics, sizeof(this->diagnostics));
+            other.block = nullptr;
+            other.owned = true;
+            other.detach();
+            other.diagnostic_count = 0;
+            return *this;
+        };
+        ~ParseResult(){
+            if (this->owned)
+                free(this->block);
+        };
+
+        static int sizeFor(int count, int argc){
+            int words = (count+63)/64;
+            int slots = argc + count;
+            return 2*words*8 + (slots+count)*sizeof(const char*) + count*sizeof(_typed_value) + (4*count + argc + slots)*sizeof(int) + count;
+        };
+        /**
+         * @brief Parse into storage owned by the caller from now on, nothing is allocated while it is large enough
+         *
+         * The storage has to outlive every read of this result, storage is aligned up to 8 bytes first
+         */
+        void attach(void* storage, int bytes){
+            this->detach();
+            int skip = (8 - (uintptr_t)storage % 8) % 8;
+            this->block = (char*)storage + skip;
+            this->capacity = bytes > skip ? bytes-skip : 0;
+            this->owned = false;
+        };
+        //back to heap storage, the next reset() allocates
+        void detach(){
+            if (this->owned)
+                free(this->block);
+            this->block = nullptr;
+            this->capacity = 0;
+            this->owned = true;
+            this->bytes = 0;
+            this->count = 0;
+            this->words = 0;
+            this->argc = 0;
+            this->slots = 0;
+        };
+        /**
+         * @brief Sizes and zeroes the block for a parse, the allocation is reused if it is large enough
+         *
+         * Attached storage is never replaced by the heap, ERR_CAPACITY if it is too small (the result stays empty)
+         */
+        int reset(int count, int argc){
+            int bytes = sizeFor(count, argc);
+            if (this->capacity < bytes){
+                if (!this->owned){
+                    this->bytes = this->count = this->words = this->argc = this->slots = 0;
+                    return ERR_CAPACITY;
+                }
+                free(this->block);
+                this->block = (char*)malloc(bytes);
+                this->capacity = bytes;
+            }
+            this->bytes = bytes;
+            this->count = count;
+            this->words = (count+63)/64;
+            this->argc = argc;
+            this->slots = argc + count;
+            memset(this->block, 0, bytes);
+            for (int i=0;i<argc;i++)
+                this->_owner()[i] = -1;
+            this->diagnostic_count = 0;
+            return ERR_NO_ERR;
+        };
+
+        uint64_t* _present() const{
+            return (uint64_t*)this->block;
+        };
+        //required arguments that were not given, only filled by the parser
+        uint64_t* _missing() const{
+            return this->_present()+this->words;
+        };
+        const char** _values() const{
+            return (const char**)(this->_missing()+this->words);
+        };
+        //the environment value per id, only meaningful for ids with source CLI_SOURCE_ENV
+        char** _env() const{
+            return (char**)(this->_values()+this->slots);
+        };
+        _typed_value* _typed() const{
+            return (_typed_value*)(this->_env()+this->count);
+        };
+        int* _occurrences() const{
+            return (int*)(this->_typed()+this->count);
+        };
+        int* _value_offset() const{
+            return this->_occurrences()+this->count;
+        };
+        int* _value_count() const{
+            return this->_value_offset()+this->count;
+        };
+        //choice index + 1 per id, 0 when the argument has no choices or was not given
+        int* _choice_ids() const{
+            return this->_value_count()+this->count;
+        };
+        int* _owner() const{
+            return this->_choice_ids()+this->count;
+        };
+        int* _value_argv() const{
+            return this->_owner()+this->argc;
+        };
+        unsigned char* _source() const{
+            return (unsigned char*)(this->_value_argv()+this->slots);
+        };
+
+        bool has(int id) const{
+            return id >= 0 && id < this->count && (this->_present()[id>>6] >> (id&63)) & 1;
+        };
+        int occurrences(int id) const{
+            return this->_occurrences()[id];
+        };
+        //a required argument (or a required parameter of a given flag) that was not given
+        bool isMissing(int id) const{
+            return id >= 0 && id < this->count && (this->_missing()[id>>6] >> (id&63)) & 1;
+        };
+        //writes up to capacity ids of missing required arguments into ids, returns how many are missing
+        int missing(int* ids, int capacity) const{
+            int n = 0;
+            for (int w=0;w<this->words;w++)
+                for (uint64_t todo = this->_missing()[w];todo != 0;todo &= todo-1, n++)
+                    if (n < capacity)
+                        ids[n] = w*64 + __builtin_ctzll(todo);
+            return n;
+        };
+        int valueCount(int id) const{
+            return this->_value_count()[id];
+        };
+        //the k-th value of an argument, nullptr if there is none
+        const char* value(int id, int k=0) const{
+            return this->has(id) && k < this->_value_count()[id] ? this->_values()[this->_value_offset()[id]+k] : nullptr;
+        };
+        /**
+         * @brief The decoded value of a typed parameter (int, double, bool, uint64, size, duration, port, ipv4, ipv6)
+         *
+         * Holds the last accepted value, only meaningful while has(id)
+         */
+        long long integer(int id) const{
+            return this->_typed()[id].integer;
+        };
+        unsigned long long uinteger(int id) const{
+            return this->_typed()[id].uinteger;
+        };
+        double real(int id) const{
+            return this->_typed()[id].real;
+        };
+        bool boolean(int id) const{
+            return this->_typed()[id].integer != 0;
+        };
+        //network byte order, 4 bytes for ipv4, 16 for ipv6
+        const unsigned char* address(int id) const{
+            return this->_typed()[id].address;
+        };
+        //index of the given value within the choices of the argument (addChoices), -1 if there is none
+        int choice(int id) const{
+            return this->_choice_ids()[id]-1;
+        };
+        //all values of an argument next to each other, valueCount(id) of them
+        const char* const* values(int id) const{
+            return this->_values()+this->_value_offset()[id];
+        };
+        //the argv index the k-th value came from, -1 for values from the environment
+        int valueIndex(int id, int k=0) const{
+            return this->_value_argv()[this->_value_offset()[id]+k];
+        };
+        //the argument id that consumed argv[i], -1 if none did
+        int owner(int i) const{
+            return this->_owner()[i];
+        };
+        int source(int id) const{
+            return this->_source()[id];
+        };
+
+        bool has(const Argument* arg) const{
+            return this->has(arg->id);
+        };
+        int occurrences(const Argument* arg) const{
+            return this->occurrences(arg->id);
+        };
+        int valueCount(const Argument* arg) const{
+            return this->valueCount(arg->id);
+        };
+        const char* value(const Argument* arg, int k=0) const{
+            return this->value(arg->id, k);
+        };
+        const char* const* values(const Argument* arg) const{
+            return this->values(arg->id);
+        };
+        int choice(const Argument* arg) const{
+            return this->choice(arg->id);
+        };
+        int source(const Argument* arg) const{
+            return this->source(arg->id);
+        };
+        int valueIndex(const Argument* arg, int k=0) const{
+            return this->valueIndex(arg->id, k);
+        };
+        bool isMissing(const Argument* arg) const{
+            return this->isMissing(arg->id);
+        };
+        long long integer(const Argument* arg) const{
+            return this->integer(arg->id);
+        };
+        unsigned long long uinteger(const Argument* arg) const{
+            return this->uinteger(arg->id);
+        };
+        double real(const Argument* arg) const{
+            return this->real(arg->id);
+        };
+        bool boolean(const Argument* arg) const{
+            return this->boolean(arg->id);
+        };
+        const unsigned char* address(const Argument* arg) const{
+            return this->address(arg->id);
+        };
+
+        //parse time, values are first counted per id and placed contiguously by finish()
+        void _mark(int id, int source){
+            this->_present()[id>>6] |= (uint64_t)1 << (id&63);
+            this->_source()[id] = source;
+            this->_value_count()[id]++;
+        };
+        //records a problem at argv[at] (-1 for none), only the first CLI_MAX_DIAGNOSTICS are kept, all are counted
+        void _report(int kind, int at, int offset, int id, int detail, const char* text){
+            if (this->diagnostic_count < CLI_MAX_DIAGNOSTICS){
+                Diagnostic d = {kind, at, offset, id, detail, -1, text};
+                this->diagnostics[this->diagnostic_count] = d;
+            }
+            this->diagnostic_count++;
+        };
+        void _consume(int id, int i){
+            this->_owner()[i] = id;
+            this->_mark(id, CLI_SOURCE_ARGV);
+        };
+        //counting sort of the recorded values by id, argv order is kept within an argument
+        void _finish(char** argv){
+            int offset = 0;
+            for (int id=0;id<this->count;id++){
+                this->_value_offset()[id] = offset;
+                offset += this->_value_count()[id];
+                this->_value_count()[id] = 0;
+            }
+            for (int i=0;i<this->argc;i++){
+                int id = this->_owner()[i];
+                if (id < 0)
+                    continue;
+                int slot = this->_value_offset()[id] + this->_value_count()[id]++;
+                this->_values()[slot] = argv[i];
+                this->_value_argv()[slot] = i;
+            }
+            for (int id=0;id<this->count;id++){
+                if (this->_source()[id] != CLI_SOURCE_ENV)
+                    continue;
+                int slot = this->_value_offset()[id] + this->_value_count()[id]++;
+                this->_values()[slot] = this->_env()[id];
+                this->_value_argv()[slot] = -1;
+            }
+        };
+        //keeps only the last recorded value of id (CLI_REPEAT_LAST, CLI_REPEAT_COUNT)
+        void _keep_last(int id){
+            int n = this->_value_count()[id];
+            if (n <= 1)
+                return;
+            this->_value_offset()[id] += n-1;
+            this->_value_count()[id] = 1;
+        };
+    };
+
+    /**************************************************************************************************************************************
+     * LIST VALUES
+     *
+    */
+    struct _list_chunk
+    {
+        int                                     id;
+        int                                     dtype;
+        int                                     begin;          // into the array of the dtype
+        int                                     count;
+    };
+
+    struct _list_span
+    {
+        int                                     begin;
+        int                                     count;
+        int                                     chunks;
+    };
+
+    /**
+     * @brief Typed contiguous storage of all list parameters (int[], double[], string[]) of one parse
+     *
+     *      cli::NewParamter("ids", "int[]");               // --ids 1,2,3
+     *      const cli::ListValues& lists = myCommandLine.lists();
+     *      const long long* ids = lists.integers(param);   // lists.count(param) of them
+     *
+     * Every occurrence is decoded once while parsing, repeated occurrences of one argument are joined after the
+     * parse so each argument ends up as one run. The buffers are kept and reused by the next parse.
+     */
+    struct ListValues
+    {
+        std::vector<long long>                  ints;
+        std::vector<double>                     reals;
+        std::vector<char>                       chars;          // string elements, each '\0' terminated
+        std::vector<int>                        string_offsets; // into chars, one per string element
+        std::vector<const char*>                strings;        // resolved from string_offsets by _finish()
+        std::vector<_list_chunk>                chunks;         // one per decoded occurrence, in argv order
+        std::vector<_list_span>                 spans;          // per argument id
+
+        int count(int id) const{
+            return id >= 0 && id < (int)this->spans.size() ? this->spans[id].count : 0;
+        };
+        const long long* integers(int id) const{
+            return this->ints.data()+this->spans[id].begin;
+        };
+        const double* doubles(int id) const{
+            return this->reals.data()+this->spans[id].begin;
+        };
+        const char* const* strs(int id) const{
+            return this->strings.data()+this->spans[id].begin;
+        };
+        int count(const Argument* arg) const{
+            return this->count(arg->id);
+        };
+        const long long* integers(const Argument* arg) const{
+            return this->integers(arg->id);
+        };
+        const double* doubles(const Argument* arg) const{
+            return this->doubles(arg->id);
+        };
+        const char* const* strs(const Argument* arg) const{
+            return this->strs(arg->id);
+        };
+
+        //the vectors with any storage and their bytes, to see what a parse allocated
+        int _capacity(uint64_t* bytes) const{
+            size_t caps[] = {this->ints.capacity()*sizeof(long long), this->reals.capacity()*sizeof(double), this->chars.capacity(), 
+                             this->string_offsets.capacity()*sizeof(int), this->strings.capacity()*sizeof(const char*), 
+                             this->chunks.capacity()*sizeof(_list_chunk), this->spans.capacity()*sizeof(_list_span)};
+            int vectors = 0;
+            *bytes = 0;
+            for (int k=0;k<7;k++){
+                vectors += caps[k] > 0;
+                *bytes += caps[k];
+            }
+            return vectors;
+        };
+
+        /**
+         * @brief Room for tokens list values of chars characters in total (terminators included), so that neither
+         * decoding nor joining repeated occurrences grows a vector
+         *
+         * An element takes at least one character and its separator, joining copies each element at most once.
+         */
+        void _reserve(int count, int dtypes, int tokens, int chars){
+            if (dtypes == 0)
+                return;
+            this->spans.reserve(count);
+            this->chunks.reserve(tokens);
+            if (dtypes & (1 << CLI_DTYPE_INT_LIST))
+                this->ints.reserve(chars);
+            if (dtypes & (1 << CLI_DTYPE_DOUBLE_LIST))
+                this->reals.reserve(chars);
+            if (dtypes & (1 << CLI_DTYPE_STRING_LIST)){
+                this->chars.reserve(chars);
+                this->string_offsets.reserve(chars);
+                this->strings.reserve(chars);
+            }
+        };
+
+        void _reset(){
+            this->ints.clear();
+            this->reals.clear();
+            this->chars.clear();
+            this->string_offsets.clear();
+            this->strings.clear();
+            this->chunks.clear();
+            this->spans.clear();
+        };
+
+        //decodes one occurrence of a list parameter, nothing is kept on ERR_WRONG_DATA or ERR_OUT_OF_RANGE, offset is
+        //set to the start of the failing element then (and check for ERR_OUT_OF_RANGE)
+        int _decode(const Argument* arg, const char* value, int* check, int* offset){
+            _list_chunk chunk;
+            chunk.id = arg->id;
+            chunk.dtype = arg->dtype;
+            const char* p = value;
+            char separator = arg->separator;
+            if (arg->dtype == CLI_DTYPE_INT_LIST){
+                chunk.begin = this->ints.size();
+                for (;;p++){
+                    long long number;
+                    *offset = p-value;
+                    if (_decode_integer(p, separator, &number, &p) != ERR_NO_ERR){
+                        this->ints.resize(chunk.begin);
+                        return ERR_WRONG_DATA;
+                    }
+                    if (arg->constraint.checks != 0){
+                        _typed_value typed;
+                        typed.integer = number;
+                        if ((*check = _check_constraint(arg->constraint, arg->dtype, typed)) != 0){
+                            this->ints.resize(chunk.begin);
+                            return ERR_OUT_OF_RANGE;
+                        }
+                    }
+                    this->ints.push_back(number);
+                    if (*p == '\0')
+                        break;
+                }
+                chunk.count = this->ints.size()-chunk.begin;
+            }else if (arg->dtype == CLI_DTYPE_DOUBLE_LIST){
+                chunk.begin = this->reals.size();
+                for (;;p++){
+                    const char* end;
+                    double number;
+                    *offset = p-value;
+                    if (_decode_double(p, &number, &end) != ERR_NO_ERR || (*end != separator && *end != '\0')){
+                        this->reals.resize(chunk.begin);
+                        return ERR_WRONG_DATA;
+                    }
+                    if (arg->constraint.checks != 0){
+                        _typed_value typed;
+                        typed.real = number;
+                        if ((*check = _check_constraint(arg->constraint, arg->dtype, typed)) != 0){
+                            this->reals.resize(chunk.begin);
+                            return ERR_OUT_OF_RANGE;
+                        }
+                    }
+                    this->reals.push_back(number);
+                    p = end;
+                    if (*p == '\0')
+                        break;
+                }
+                chunk.count = this->reals.size()-chunk.begin;
+            }else{
+                chunk.begin = this->string_offsets.size();
+                int base = this->chars.size();
+                int l = strlen(value);
+                this->chars.insert(this->chars.end(), value, value+l);
+                this->string_offsets.push_back(base);
+                for (int i=base;i<base+l-1;i++){
+                    if (this->chars[i] == separator){
+                        this->chars[i] = '\0';
+                        this->string_offsets.push_back(i+1);
+                    }
+                }
+                chunk.count = this->string_offsets.size()-chunk.begin;
+            }
+            this->chunks.push_back(chunk);
+            return ERR_NO_ERR;
+        };
+
+        //one run per argument: a single occurrence is used in place, repeated ones are appended joined
+        void _finish(int count){
+            this->spans.assign(count, _list_span());
+            for (int c=0;c<(int)this->chunks.size();c++){
+                _list_span& span = this->spans[this->chunks[c].id];
+                if (span.chunks++ == 0){
+                    span.begin = this->chunks[c].begin;
+                    span.count = this->chunks[c].count;
+                }
+            }
+            for (int id=0;id<count;id++)
+                if (this->spans[id].chunks > 1)
+                    this->spans[id].count = 0;
+            for (int c=0;c<(int)this->chunks.size();c++){
+                const _list_chunk& chunk = this->chunks[c];
+                _list_span& span = this->spans[chunk.id];
+                if (span.chunks < 2)
+                    continue;
+                if (span.count == 0)
+                    span.begin = chunk.dtype == CLI_DTYPE_INT_LIST ? this->ints.size() : 
+                                 chunk.dtype == CLI_DTYPE_DOUBLE_LIST ? this->reals.size() : this->string_offsets.size();
+                for (int k=chunk.begin;k<chunk.begin+chunk.count;k++){
+                    if (chunk.dtype == CLI_DTYPE_INT_LIST)
+                        this->ints.push_back(this->ints[k]);
+                    else if (chunk.dtype == CLI_DTYPE_DOUBLE_LIST)
+                        this->reals.push_back(this->reals[k]);
+                    else
+                        this->string_offsets.push_back(this->string_offsets[k]);
+                }
+                span.count += chunk.count;
+            }
+            this->strings.resize(this->string_offsets.size());
+            for (int k=0;k<(int)this->string_offsets.size();k++)
+                this->strings[k] = this->chars.data()+this->string_offsets[k];
+        };
+
+        //after _finish(), the run of id is only its last occurrence (CLI_REPEAT_LAST, CLI_REPEAT_COUNT)
+        void _keep_last(int id){
+            if (id < 0 || id >= (int)this->spans.size() || this->spans[id].chunks < 2)
+                return;
+            for (int c=this->chunks.size()-1;c>=0;c--){
+                if (this->chunks[c].id != id)
+                    continue;
+                this->spans[id].begin = this->chunks[c].begin;
+                this->spans[id].count = this->chunks[c].count;
+                this->spans[id].chunks = 1;
+                return;
+            }
+        };
+    };
+
+    /**************************************************************************************************************************************
+     * SNAPSHOT
+     *
+    */
+    struct _snapshot_node
+    {
+        int                                     key;            // offset into the string area
+        int                                     data;           // offset into the string area
+        int                                     first_child;    // children are stored next to each other (breadth first)
+        int                                     child_count;
+        ArgumentType                            arg_type;
+    };
+
+    //header of the single allocation: refs | nodes[node_count] | strings
+    struct _snapshot_block
+    {
+        std::atomic<int>                        refs;
+        int                                     node_count;
+        int                                     string_bytes;
+
+        const _snapshot_node* nodes() const{
+            return (const _snapshot_node*)(this+1);
+        };
+        const char* strings() const{
+            return (const char*)(this->nodes()+this->node_count);
+        };
+    };
+
+    /**
+     * @brief A frozen copy of the parsed arguments, laid out like the Options tree of parsedArgs()
+     *
+     * All keys, values and children live in one allocation that is never written after it was built, so a
+     * Snapshot can be read through const& from any number of threads without synchronization.
+     * Copies share the allocation through an atomic reference count, the last one frees it.
+     *
+     *      cli::Snapshot snap = myCommandLine.snapshot();
+     *      const char* number = snap.root().get("reference").get("number").data();
+     */
+    struct Snapshot
+    {
+        struct Node
+        {
+            const _snapshot_block*              block;
+            int                                 index;          // -1 for a missing node
+
+            bool valid() const{
+                return this->index >= 0;
+            };
+            const char* key() const{
+                return this->valid() ? this->block->strings()+this->block->nodes()[this->index].key : "__null__";
+            };
+            const char* data() const{
+                return this->valid() ? this->block->strings()+this->block->nodes()[this->index].data : "__null__";
+            };
+            ArgumentType argType() const{
+                return this->valid() ? this->block->nodes()[this->index].arg_type : _NULL_ARG_;
+            };
+            int size() const{
+                return this->valid() ? this->block->nodes()[this->index].child_count : 0;
+            };
+            Node child(int i) const{
+                return Node{this->block, this->block->nodes()[this->index].first_child+i};
+            };
+            //like Options::get, but a miss returns an invalid node instead of allocating one
+            Node get(const char* key) const{
+                for (int i=0;i<this->size();i++)
+                    if (_compare_cstring(key, (char*)this->child(i).key()))
+                        return this->child(i);
+                return Node{this->block, -1};
+            };
+            Node operator[](const char* key) const{
+                return this->get(key);
+            };
+        };
+
+        _snapshot_block*                        block;
+
+        Snapshot(){
+            this->block = nullptr;
+        };
+        explicit Snapshot(_snapshot_block* block){
+            this->block = block;
+        };
+        Snapshot(const Snapshot& other){
+            this->block = other.block;
+            if (this->block != nullptr)
+                this->block->refs.fetch_add(1, std::memory_order_relaxed);
+        };
+        Snapshot& operator=(const Snapshot& other){
+            if (other.block != nullptr)
+                other.block->refs.fetch_add(1, std::memory_order_relaxed);
+            this->release();
+            this->block = other.block;
+            return *this;
+        };
+        ~Snapshot(){
+            this->release();
+        };
+        void release(){
+            if (this->block != nullptr && this->block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1){
+                this->block->~_snapshot_block();
+                free(this->block);
+            }
+            this->block = nullptr;
+        };
+
+        bool valid() const{
+            return this->block != nullptr;
+        };
+        int size() const{
+            return this->valid() ? this->block->node_count : 0;
+        };
+        Node root() const{
+            return Node{this->block, this->valid() ? 0 : -1};
+        };
+    };
+
+    /**
+     * @brief Freezes a parse result into a Snapshot, breadth first so the children of every node are contiguous
+     *
+     * Read straight from the flat ParseResult and the schema, no Options tree is built for it. The nodes are the ones
+     * parsedArgs() would have: the root, then every present argument below its present parent with its first value.
+     */
+    Snapshot _freeze(const Argument* root, const ParseResult& result){
+        std::vector<const Argument*> order(1, root);
+        std::vector<int> child_count(1, 0);
+        int bytes = strlen(root->long_flag) + strlen("__null__");
+        for (int i=0;i<(int)order.size();i++){
+            for (int q=0;q<(int)order[i]->arguments.size();q++){
+                const Argument* child = order[i]->arguments[q];
+                if (!result.has(child->id))
+                    continue;
+                const char* value = result.value(child->id);
+                bytes += strlen(child->long_flag) + strlen(value != nullptr ? value : "__null__");
+                order.push_back(child);
+                child_count.push_back(0);
+                child_count[i]++;
+            }
+        }
+
+        _snapshot_block* block = (_snapshot_block*)malloc(sizeof(_snapshot_block) + order.size()*sizeof(_snapshot_node) + bytes);
+        new (&block->refs) std::atomic<int>(1);
+        block->node_count = order.size();
+        block->string_bytes = bytes;
+
+        _snapshot_node* nodes = (_snapshot_node*)(block+1);
+        char* strings = (char*)(nodes+order.size());
+        int offset = 0;
+        int next_child = 1;
+        for (int i=0;i<(int)order.size();i++){
+            const char* data = i == 0 ? nullptr : result.value(order[i]->id);
+            if (data == nullptr)
+                data = "__null__";
+            nodes[i].key = offset;
+            write_string(strings+offset, order[i]->long_flag);
+            offset += strlen(order[i]->long_flag);
+            nodes[i].data = offset;
+            write_string(strings+offset, (char*)data);
+            offset += strlen(data);
+            nodes[i].arg_type = i == 0 ? _NULL_ARG_ : order[i]->arg_type;
+            nodes[i].first_child = next_child;
+            nodes[i].child_count = child_count[i];
+            next_child += child_count[i];
+        }
+        return Snapshot(block);
+    }
+
+    /**
+     * @brief One memory mapped message catalog, the translations of one locale
+     *
+     *      "CLICAT1\0" | uint32 arg_count | uint32 error_count | uint32 arg_offset[arg_count] |
+     *      uint32 error_offset[error_count] | '\0' terminated UTF-8 strings
+     *
+     * Help texts are indexed by Argument::id, error messages by the bit position of their ERR_* code. An offset of 0
+     * means "not translated", the built in text is used then. Only the pages of the looked up strings are touched.
+     */
+    struct _catalog
+    {
+        const char*                             map;        // nullptr while nothing is mapped
+        size_t                                  size;
+        uint32_t                                arg_count;
+        uint32_t                                error_count;
+        bool                                    tried;      // the lookup for the current pattern and locale ran already
+        std::string                             pattern;    // path with %s for the locale, see CommandLine::setCatalog()
+        std::string                             locale;     // empty for the one of the environment
+
+        _catalog(){
+            this->map = nullptr;
+            this->size = 0;
+            this->arg_count = 0;
+            this->error_count = 0;
+            this->tried = false;
+        };
+        //a copy maps the file again on its own first lookup
+        _catalog(const _catalog& other) : _catalog(){
+            this->pattern = other.pattern;
+            this->locale = other.locale;
+        };
+        _catalog& operator=(const _catalog& other){
+            if (this != &other){
+                this->close();
+                this->pattern = other.pattern;
+                this->locale = other.locale;
+            }
+            return *this;
+        };
+        ~_catalog(){
+            this->close();
+        };
+
+        void close(){
+            if (this->map != nullptr)
+                munmap((void*)this->map, this->size);
+            this->map = nullptr;
+            this->size = 0;
+            this->tried = false;
+        };
+
+        //maps path if it is a well formed catalog, ERR_NOT_FOUND otherwise (nothing stays mapped then)
+        int open(const char* path){
+            this->close();
+            this->tried = true;
+            int fd = ::open(path, O_RDONLY);
+            if (fd < 0)
+                return ERR_NOT_FOUND;
+            struct stat st;
+            void* map = fstat(fd, &st) == 0 && st.st_size >= 16 ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            ::close(fd);
+            if (map == MAP_FAILED)
+                return ERR_NOT_FOUND;
+            uint32_t counts[2];
+            memcpy(counts, (const char*)map+8, sizeof(counts));
+            if (memcmp(map, CLI_CATALOG_MAGIC, 8) != 0 || 16 + 4*((uint64_t)counts[0]+counts[1]) > (uint64_t)st.st_size){
+                munmap(map, st.st_size);
+                return ERR_NOT_FOUND;
+            }
+            this->map = (const char*)map;
+            this->size = st.st_size;
+            this->arg_count = counts[0];
+            this->error_count = counts[1];
+            return ERR_NO_ERR;
+        };
+
+        /**
+         * @brief Maps the catalog of the locale on the first call, later calls return whether one is mapped
+         *
+         * The locale is the one set, else LC_ALL, LC_MESSAGES or LANG. "de_DE.UTF-8@euro" tries the pattern with
+         * "de_DE" first and then with "de", "C" and "POSIX" use the built in texts. Returns true when a catalog was mapped
+         * by this call (rendered texts are stale then).
+         */
+        bool load(){
+            if (this->tried || this->pattern.empty())
+                return false;
+            this->tried = true;
+            const char* name = this->locale.empty() ? nullptr : this->locale.c_str();
+            const char* vars[] = {"LC_ALL", "LC_MESSAGES", "LANG"};
+            for (int v=0;v<3 && (name == nullptr || name[0] == '\0');v++)
+                name = getenv(vars[v]);
+            if (name == nullptr || name[0] == '\0' || strcmp(name, "C") == 0 || strcmp(name, "POSIX") == 0)
+                return false;
+            std::string full(name, strcspn(name, ".@"));
+            std::string names[2] = {full, full.substr(0, full.find('_'))};
+            for (int n=0;n<2;n++){
+                if (names[n].empty() || (n == 1 && names[1] == names[0]))
+                    continue;
+                std::string path;
+                size_t at = this->pattern.find("%s");
+                path = at == std::string::npos ? this->pattern : this->pattern.substr(0, at) + names[n] + this->pattern.substr(at+2);
+                if (this->open(path.c_str()) == ERR_NO_ERR)
+                    return true;
+            }
+            return false;
+        };
+
+        //the string at slot of the offset table, nullptr if it is not translated or not terminated within the file
+        const char* _text(uint32_t slot) const{
+            uint32_t offset;
+            memcpy(&offset, this->map+16+4*slot, 4);
+            if (offset == 0 || offset >= this->size || memchr(this->map+offset, '\0', this->size-offset) == nullptr)
+                return nullptr;
+            return this->map+offset;
+        };
+        const char* help(int id) const{
+            if (this->map == nullptr || id < 0 || id >= (int)this->arg_count)
+                return nullptr;
+            return this->_text(id);
+        };
+        const char* error(int bit) const{
+            if (this->map == nullptr || bit < 0 || bit >= (int)this->error_count)
+                return nullptr;
+            return this->_text(this->arg_count+bit);
+        };
+    };
+
+    //"--flag" for flags, "--flag <param>" for parameters of a flag, "<param>" for positionals
+    int _argument_name(const Argument* arg, const Argument* root, char* buffer, int size){
+        if (!(arg->arg_type&PARAM))
+            return snprintf(buffer, size, "--%s", arg->long_flag);
+        if (arg->parent != nullptr && arg->parent != root)
+            return snprintf(buffer, size, "--%s <%s>", arg->parent->long_flag, arg->long_flag);
+        return snprintf(buffer, size, "<%s>", arg->long_flag);
+    }
+
+    //the left column of a help row: "-p, --port <number!>", methods by name, positionals as "<name>"
+    void _help_column(const Argument* arg, int depth, bool full, std::string* out){
+        out->append(4 + 2*depth, ' ');
+        if (arg->arg_type&PARAM){
+            out->append("<").append(arg->long_flag).append(arg->required ? "!>" : ">");
+            return;
+        }
+        if (arg->arg_type&METHOD){
+            out->append(arg->long_flag);
+            if (arg->short_flag[0] != '\0')
+                out->append(", ").append(arg->short_flag);
+        }else{
+            if (arg->short_flag[0] != '\0')
+                out->append("-").append(arg->short_flag).append(", ");
+            else
+                out->append("    ");
+            out->append("--").append(arg->long_flag);
+        }
+        for (int k=0;k<(int)arg->arguments.size();k++){
+            const Argument* param = arg->arguments[k];
+            if (!(param->arg_type&PARAM))
+                continue;
+            out->append(" <").append(param->long_flag);
+            if (full)
+                out->append(":").append(param->is_custom_dtype && param->dtype_custom != nullptr ? param->dtype_custom : _dtype_name(param->dtype));
+            out->append(param->required ? "!>" : ">");
+        }
+    }
+
+    //the help message of arg, nullptr without, a packed one is valid until the next lookup in texts
+    const char* _help_of(const Argument* arg, _help_store* texts){
+        return arg->help_ref >= 0 ? texts->get(arg->help_ref) : arg->help_msg;
+    }
+
+    //the help message and, in the full help, the choices of the parameters
+    void _help_text(const Argument* arg, const _catalog& messages, _help_store* texts, std::string* out){
+        const char* help = messages.help(arg->id);
+        if (help == nullptr)
+            help = _help_of(arg, texts);
+        if (help != nullptr)
+            out->append(help);
+        for (int k=-1;k<(int)arg->arguments.size();k++){
+            const Argument* param = k < 0 ? arg : arg->arguments[k];
+            if (!(param->arg_type&PARAM) || param->choice_count == 0)
+                continue;
+            out->append(" {");
+            for (int c=0;c<param->choice_count;c++)
+                out->append(c > 0 ? "|" : "").append(param->choices[c]);
+            out->append("}");
+        }
+    }
+
+    //arg and the flags and methods below it in declaration order, parameters are part of their flag's row
+    void _help_rows(const Argument* arg, int depth, std::vector<const Argument*>* rows, std::vector<int>* depths){
+        for (int i=0;i<(int)arg->arguments.size();i++){
+            const Argument* child = arg->arguments[i];
+            if (child->arg_type&PARAM && depth > 0)
+                continue;
+            rows->push_back(child);
+            depths->push_back(depth);
+            _help_rows(child, depth+1, rows, depths);
+        }
+    }
+
+    //lowercase trigram of the three bytes at p
+    inline uint32_t _trigram(const char* p){
+        return (uint32_t)(unsigned char)tolower(p[0]) << 16 | (uint32_t)(unsigned char)tolower(p[1]) << 8 | (unsigned char)tolower(p[2]);
+    }
+
+    /**
+     * @brief Trigram index over the help rows for --help=<pattern>, built once per schema version
+     *
+     * Every row is indexed by the lowercase text of its full help line (flags, parameters, dtypes, help message and
+     * choices). A query takes the shortest posting list among the trigrams of the pattern and only verifies those
+     * rows with a substring search, patterns shorter than three bytes are checked against every row.
+     */
+    struct _help_index
+    {
+        std::vector<const Argument*>            rows;           // _help_rows() order
+        std::vector<int>                        depths;
+        std::string                             corpus;         // lowercase searchable text per row, each '\0' terminated
+        std::vector<int>                        row_begin;      // into corpus
+        std::vector<uint32_t>                   keys;           // distinct trigrams, sorted
+        std::vector<int>                        key_begin;      // keys.size()+1 offsets into postings
+        std::vector<int>                        postings;       // row indices, ascending per trigram
+        int                                     version;
+
+        _help_index(){
+            this->version = -1;
+        };
+
+        void build(const Argument* root, const _catalog& messages, _help_store* texts){
+            this->rows.clear();
+            this->depths.clear();
+            _help_rows(root, 0, &this->rows, &this->depths);
+            this->corpus.clear();
+            this->row_begin.clear();
+            std::vector<uint64_t> pairs;    // trigram << 32 | row
+            for (int r=0;r<(int)this->rows.size();r++){
+                int begin = this->corpus.size();
+                this->row_begin.push_back(begin);
+                _help_column(this->rows[r], 0, true, &this->corpus);
+                this->corpus.append(" ");
+                _help_text(this->rows[r], messages, texts, &this->corpus);
+                for (int k=begin;k<(int)this->corpus.size();k++)
+                    this->corpus[k] = tolower((unsigned char)this->corpus[k]);
+                for (int k=begin;k+2<(int)this->corpus.size();k++)
+                    pairs.push_back((uint64_t)_trigram(&this->corpus[k]) << 32 | r);
+                this->corpus.push_back('\0');
+            }
+            std::sort(pairs.begin(), pairs.end());
+            pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+            this->keys.clear();
+            this->key_begin.clear();
+            this->postings.clear();
+            for (int k=0;k<(int)pairs.size();k++){
+                uint32_t key = pairs[k] >> 32;
+                if (this->keys.empty() || this->keys.back() != key){
+                    this->keys.push_back(key);
+                    this->key_begin.push_back(k);
+                }
+                this->postings.push_back((int)(pairs[k] & 0xFFFFFFFF));
+            }
+            this->key_begin.push_back(pairs.size());
+        };
+
+        //the rows whose text contains pattern (case insensitive), in row order
+        void find(const char* pattern, std::vector<int>* matches) const{
+            matches->clear();
+            std::string needle(pattern);
+            for (int k=0;k<(int)needle.size();k++)
+                needle[k] = tolower((unsigned char)needle[k]);
+            int all = this->rows.size();
+            const int* candidates = nullptr;
+            int count = all;
+            for (int k=0;k+2<(int)needle.size();k++){
+                std::vector<uint32_t>::const_iterator key = std::lower_bound(this->keys.begin(), this->keys.end(), _trigram(&needle[k]));
+                if (key == this->keys.end() || *key != _trigram(&needle[k]))
+                    return;
+                int at = key - this->keys.begin();
+                int n = this->key_begin[at+1] - this->key_begin[at];
+                if (n < count || candidates == nullptr){
+                    candidates = &this->postings[this->key_begin[at]];
+                    count = n;
+                }
+            }
+            for (int c=0;c<count;c++){
+                int r = candidates != nullptr ? candidates[c] : c;
+                if (strstr(&this->corpus[this->row_begin[r]], needle.c_str()) != nullptr)
+                    matches->push_back(r);
+            }
+        };
+    };
+
+    //one traced step of a parse, 24 bytes
+    struct TraceEvent
+    {
+        uint64_t                                time;           // CLOCK_MONOTONIC nanoseconds
+        int                                     event;          // CLI_EVENT_*
+        int                                     id;             // Argument::id, -1 if none
+        int                                     argv_index;     // -1 if none
+        int                                     detail;
+    };
+
+    /**
+     * @brief The events of the last parse in a fixed ring, recording is a few stores and one clock read
+     *
+     * Only CLI_TRACE() records, which compiles to nothing without CLI_ENABLE_TRACE, the ring then stays empty.
+     */
+    struct TraceRing
+    {
+        TraceEvent                              events[CLI_TRACE_CAPACITY];
+        uint32_t                                total;          // recorded since reset(), the last CLI_TRACE_CAPACITY are kept
+
+        TraceRing(){
+            this->total = 0;
+        };
+        void reset(){
+            this->total = 0;
+        };
+        void record(int event, int id, int argv_index, int detail){
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            TraceEvent& e = this->events[this->total++ % CLI_TRACE_CAPACITY];
+            e.time = (uint64_t)now.tv_sec*1000000000ull + now.tv_nsec;
+            e.event = event;
+            e.id = id;
+            e.argv_index = argv_index;
+            e.detail = detail;
+        };
+        int count() const{
+            return this->total < CLI_TRACE_CAPACITY ? this->total : CLI_TRACE_CAPACITY;
+        };
+        //the k-th kept event, oldest first
+        const TraceEvent& at(int k) const{
+            return this->events[(this->total - this->count() + k) % CLI_TRACE_CAPACITY];
+        };
+    };
+
+    /**
+     * @brief Where the time of the last parse went, filled while profiling is on (setProfiling() or --cli-profile)
+     *
+     * Phases are CLI_PHASE_*, allocations count what the parser itself allocated for its result (the result block and
+     * the growth of the list storage), string_compares the flag and wildcard comparisons that got past the hashes.
+     */
+    struct ParseProfile
+    {
+        bool                                    enabled;
+        uint64_t                                phase_ns[CLI_PHASE_COUNT];
+        uint64_t                                total_ns;
+        uint64_t                                allocations;
+        uint64_t                                allocated_bytes;
+        uint64_t                                string_compares;
+        int                                     callbacks;          // run by the last execute()
+        std::vector<uint64_t>                   validate_ns;        // per Argument::id, decoding and checking its values
+        std::vector<int>                        validated;          // values validated per id
+
+        ParseProfile(){
+            this->enabled = false;
+            this->reset(0);
+        };
+        void reset(int count){
+            for (int p=0;p<CLI_PHASE_COUNT;p++)
+                this->phase_ns[p] = 0;
+            this->total_ns = 0;
+            this->allocations = 0;
+            this->allocated_bytes = 0;
+            this->string_compares = 0;
+            this->callbacks = 0;
+            this->validate_ns.assign(count, 0);
+            this->validated.assign(count, 0);
+        };
+    };
+
+    //CLOCK_MONOTONIC in nanoseconds
+    uint64_t _now_ns(){
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint64_t)now.tv_sec*1000000000ull + now.tv_nsec;
+    }
+
+    //one span of the timeline, a CLI_PHASE_* or CLI_SPAN_* of the argument id (-1 for none)
+    struct TimelineSpan
+    {
+        uint64_t                                begin;
+        uint64_t                                end;
+        int                                     kind;
+        int                                     id;
+    };
+
+    //the spans of the last parse and the executes after it, see CommandLine::setTimeline()
+    struct Timeline
+    {
+        bool                                    enabled;
+        std::vector<TimelineSpan>               spans;
+
+        Timeline(){
+            this->enabled = false;
+        };
+        void add(uint64_t begin, uint64_t end, int kind, int id){
+            TimelineSpan span = {begin, end, kind, id};
+            this->spans.push_back(span);
         };
+    };
 
+    //adds the time since the last lap to a phase of the profile (and as a span to the timeline), does nothing (no clock read) without a profile
+    struct _phase_timer
+    {
+        ParseProfile*                           profile;
+        Timeline*                               timeline;
+        uint64_t                                last;
+
+        _phase_timer(ParseProfile* profile, Timeline* timeline){
+            this->profile = profile;
+            this->timeline = timeline;
+            this->last = profile != nullptr ? _now_ns() : 0;
+        };
+        uint64_t lap(int phase, int id=-1){
+            if (this->profile == nullptr)
+                return 0;
+            uint64_t now = _now_ns();
+            uint64_t spent = now - this->last;
+            this->profile->phase_ns[phase] += spent;
+            if (this->timeline != nullptr)
+                this->timeline->add(this->last, now, phase, id);
+            this->last = now;
+            return spent;
+        };
+        //the time until here is not charged to any phase
+        uint64_t restart(){
+            if (this->profile == nullptr)
+                return 0;
+            uint64_t now = _now_ns();
+            uint64_t skipped = now - this->last;
+            this->last = now;
+            return skipped;
+        };
+        //a lap of CLI_PHASE_VALIDATE that is also charged to the argument
+        void validated(int id){
+            if (this->profile == nullptr)
+                return;
+            this->profile->validate_ns[id] += this->lap(CLI_PHASE_VALIDATE, id);
+            this->profile->validated[id]++;
+        };
+    };
 
+    //the rendered help texts, each valid while argument_tree::version is the one it was rendered for
+    struct _help_cache
+    {
+        std::string                             text[2];        // printHelp(), printHelpFull()
+        int                                     version[2];
+        _help_index                             index;          // --help=<pattern>
 
-        int argument_tree::addArgument(Argument* arg){
-            if (CommandLineVerbosity>=VERBOSE_FULL){
-                std::cout << _get_verbosity_msg(3);
-            }
-              
-            this->methods += (arg->getArgType()&METHOD) > 0;
-            this->options += (arg->getArgType()&OPTION) > 0;
-    
-            this->root->addArgument(arg);
-            return ERR_NO_ERR;
+        _help_cache(){
+            this->version[0] = -1;
+            this->version[1] = -1;
         };
-
     };
 
-   
-
     /**
      *   THE COMMAND LINE STRUCT
      *   This struct encapsulates the datastructure after parsing, the arguments in the argument tree
@@ -700,19 +3682,75 @@ namespace cli
         argument_tree *args;
         int* cli_verbosity;
 
-        Options* options;
+        Options* options;           // built from result on the first parsedArgs() after a parse
+        Snapshot frozen;            // snapshot of result, built on first request after a parse
+        char* config_file;
+        ParseResult result;
+        ListValues list_values;
+        _help_cache help;
+        _catalog messages;          // mapped on the first help or error text, never for a plain parse
+        TraceRing trace;            // events of the last parse, only recorded with CLI_ENABLE_TRACE
+        ParseProfile profiling;     // see setProfiling()
+        Timeline timeline;          // see setTimeline()
+        bool profile_report;        // --cli-profile was given, print the profile after parse and execute
+
+        int _parse(int argc, char **argv, bool quiet);
+        const std::string& _help(bool full);
+        void _localize();
+        void _reserve_lists(int argc, char** argv);
 
     public:
         CommandLine();
         CommandLine(const char *config_file);
         CommandLine(int verbose);
         CommandLine(const char *config_file, int verbose);
+        CommandLine(CommandLine&& other);
+        CommandLine(const CommandLine&) = delete;
+        CommandLine& operator=(const CommandLine&) = delete;
+        CommandLine& operator=(CommandLine&&) = delete;
+        ~CommandLine();
         Options* build_options_tree();
         int addArgument(Argument *arg);
+        int addExclusive(const std::initializer_list<Argument*> &group);
+        int addRequires(Argument* arg, const std::initializer_list<Argument*> &dependencies);
+        int addAtLeastOne(const std::initializer_list<Argument*> &group);
         int parse(int argc, char **argv);
+        /**
+         * @brief Parse straight into a struct, all arguments bound with Argument::bind(&S::field) are written into dst
+         * while parsing, no Options tree is built (parsedArgs() only holds the empty root)
+         */
+        template <typename S>
+        int parse(int argc, char **argv, S* dst){
+            return this->parseInto(argc, argv, (void*)dst);
+        };
+        int parseInto(int argc, char **argv, void* dst);
+        int parse(int argc, char **argv, void* storage, int bytes);
+        int storageFor(int argc, char** argv = nullptr);
+        void setConfigFile(const char* path);
+        const char* getConfigFile();
+        int merge(Config* config);
         void printHelp();
         void printHelpFull();
+        void printHelp(const char* pattern);
+        int findHelp(const char* pattern, std::vector<int>* matches);
+        void setCatalog(const char* pattern);
+        void setLocale(const char* locale);
+        const char* errorText(int err);
+        int writeCatalog(const char* path);
+        const TraceRing& traced();
+        int dumpTrace(int fd);
+        void setProfiling(bool on);
+        const ParseProfile& profile();
+        int printProfile(int fd);
+        int execute();
+        void setTimeline(bool on);
+        int writeTimeline(const char* path);
         Options* parsedArgs();
+        const ParseResult& parsed();
+        Snapshot snapshot();
+        const ListValues& lists();
+        int describeError(char* buffer, int size);
+        int describe(int index, char* buffer, int size);
         Argument *operator[](char *key);
         char* string();
     };
@@ -734,6 +3772,9 @@ namespace cli
         this->verbosity = 0;
         this->cli_verbosity = &this->verbosity;
         this->args = new argument_tree(this->cli_verbosity);
+        this->config_file = nullptr;
+        this->options = nullptr;
+        this->profile_report = false;
     };
 
     CommandLine::CommandLine(const char *config_file){
@@ -744,6 +3785,9 @@ namespace cli
             std::cout << _get_verbosity_msg(12);
         }
         this->args = new argument_tree(this->cli_verbosity);
+        this->config_file = nullptr;
+        this->options = nullptr;
+        this->profile_report = false;
     };
 
     CommandLine::CommandLine(int verbose){
@@ -755,6 +3799,9 @@ namespace cli
             std::cout << _get_verbosity_msg(14);
         }
         this->args = new argument_tree(this->cli_verbosity);
+        this->config_file = nullptr;
+        this->options = nullptr;
+        this->profile_report = false;
     };
 
     CommandLine::CommandLine(const char *config_file, int verbose){
@@ -765,6 +3812,43 @@ namespace cli
             std::cout << _get_verbosity_msg(16);
         }
         this->args = new argument_tree(this->cli_verbosity);
+        this->config_file = nullptr;
+        this->options = nullptr;
+        this->profile_report = false;
+    };
+
+    //deletes node and every Options node below it
+    void _free_options(Options* node){
+        if (node == nullptr)
+            return;
+        for (int i=0;i<node->getArgc();i++)
+            _free_options(node->getOption(i));
+        delete node;
+    }
+
+    /**
+     * @brief Takes the argument tree and the last parse of other, so cli::CommandLine c = cli::CommandLine(); compiles
+     *
+     * A CommandLine is not copyable, other may only be destroyed afterwards.
+     */
+    CommandLine::CommandLine(CommandLine&& other) : 
+        frozen(other.frozen), result(std::move(other.result)), list_values(std::move(other.list_values)), help(std::move(other.help)), 
+        messages(other.messages), trace(other.trace), profiling(other.profiling), timeline(std::move(other.timeline)){
+        this->verbosity = other.verbosity;
+        this->cli_verbosity = &this->verbosity;
+        this->args = other.args;
+        this->args->verbosity = this->cli_verbosity;
+        this->options = other.options;
+        this->config_file = other.config_file;
+        this->profile_report = other.profile_report;
+        other.args = nullptr;
+        other.options = nullptr;
+        other.config_file = nullptr;
+    };
+
+    //the Options tree of the last parsedArgs() is freed with the CommandLine, the added Arguments stay with the caller
+    CommandLine::~CommandLine(){
+        _free_options(this->options);
     };
 
     /**************************************************************************************************************************************/
@@ -781,111 +3865,495 @@ namespace cli
         return ERR_NO_ERR;
     };
 
-    void CommandLine::printHelp(){
-        
-        std::cout << "USAGE:" << std::endl;
-        std::cout << "Required:\n";
-        int indent = 4;
-        for (int i=0;i<this->args->root->arguments.size();i++){ 
-            if (this->args->root->arguments[i]->required){
-                for (int ind=0;ind<indent;ind++)
-                    std::cout << " ";
-                std::cout << "[" << this->args->root->arguments[i]->long_flag << " : ";
-                if (this->args->root->arguments[i]->arguments.size()>0){
-                    for(int k=0;k<this->args->root->arguments[i]->arguments.size();k++){
-                        if (this->args->root->arguments[i]->arguments[k]->required)
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag << "!";
-                        else
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag;
-                        if (k<k<this->args->root->arguments[i]->arguments.size()-1)
-                            std::cout << ", ";
-                        else
-                            std::cout << "]\n";
-                    }
-                }
-                
-            }
-            
+    //at most one argument of the group may be given
+    int CommandLine::addExclusive(const std::initializer_list<Argument*> &group){
+        _rule rule;
+        rule.kind = CLI_RULE_EXCLUSIVE;
+        rule.members = std::vector<Argument*>(group);
+        this->args->rules.push_back(rule);
+        this->args->dirty = true;
+        this->args->version++;
+        return ERR_NO_ERR;
+    };
+
+    //when arg is given, all dependencies have to be given too
+    int CommandLine::addRequires(Argument* arg, const std::initializer_list<Argument*> &dependencies){
+        _rule rule;
+        rule.kind = CLI_RULE_REQUIRES;
+        rule.members.push_back(arg);
+        rule.members.insert(rule.members.end(), dependencies.begin(), dependencies.end());
+        this->args->rules.push_back(rule);
+        this->args->dirty = true;
+        this->args->version++;
+        return ERR_NO_ERR;
+    };
+
+    //at least one argument of the group has to be given (from argv or the environment)
+    int CommandLine::addAtLeastOne(const std::initializer_list<Argument*> &group){
+        _rule rule;
+        rule.kind = CLI_RULE_ONE_OF;
+        rule.members = std::vector<Argument*>(group);
+        this->args->rules.push_back(rule);
+        this->args->dirty = true;
+        this->args->version++;
+        return ERR_NO_ERR;
+    };
+
+    /**
+     * @brief Renders the whole help into out, the column width is taken from a first pass over all rows
+     *
+     *      USAGE:
+     *      Required:
+     *          -i, --input <path!>
+     *      Options:
+     *          -i, --input <path!>     the input file
+     *          -p, --port <number>     the port to listen on
+     *          serve                   start the server
+     *            -t, --threads <n>     worker threads
+     *
+     * The short help lists the rows only, the full help adds dtypes, the help messages and the choices.
+     */
+    void _render_help(const Argument* root, bool full, const _catalog& messages, _help_store* texts, std::string* out){
+        std::vector<const Argument*> rows;
+        std::vector<int> depths;
+        _help_rows(root, 0, &rows, &depths);
+
+        std::vector<std::string> columns(rows.size());
+        size_t width = 0;
+        for (int r=0;r<(int)rows.size();r++){
+            _help_column(rows[r], depths[r], full, &columns[r]);
+            width = std::max(width, columns[r].size());
         }
-        std::cout << "Options:\n";
-        indent = 4;
-        for (int i=0;i<this->args->root->arguments.size();i++){ 
-            if (this->args->root->arguments[i]->arg_type | OPTION | WILDCARD){
-                for (int ind=0;ind<indent;ind++)
-                    std::cout << " ";
-                std::cout << "[ " << this->args->root->arguments[i]->long_flag << ((this->args->root->arguments.size()>i+1)?" : ":" ");
-                if (this->args->root->arguments[i]->arguments.size()>0){
-                    for(int k=0;k<this->args->root->arguments[i]->arguments.size();k++){
-                        if (this->args->root->arguments[i]->arguments[k]->required)
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag << "!";
-                        else
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag;
-                        if (k<k<this->args->root->arguments[i]->arguments.size()-1)
-                            std::cout << ", ";
-                        else
-                            std::cout << "]\n";
-                    }
-                }
-                else
-                    std::cout << "]\n";
+        width += 4;
+
+        out->clear();
+        out->append("USAGE:\n");
+        if (full)
+            out->append("    Use '-vCLI | --verboseCLI' for more Debug Information\n\n");
+        out->append("Required:\n");
+        for (int r=0;r<(int)rows.size();r++)
+            if (depths[r] == 0 && rows[r]->required)
+                out->append(columns[r]).append("\n");
+        out->append("Options:\n");
+        for (int r=0;r<(int)rows.size();r++){
+            out->append(columns[r]);
+            if (full){
+                out->append(width-columns[r].size(), ' ');
+                _help_text(rows[r], messages, texts, out);
             }
+            out->append("\n");
+        }
+    }
+
+    //the matched rows of a --help=<pattern> search, formatted like the full help
+    void _render_matches(const _help_index& index, const std::vector<int>& matches, const char* pattern, const _catalog& messages, _help_store* texts, std::string* out){
+        std::vector<std::string> columns(matches.size());
+        size_t width = 0;
+        for (int m=0;m<(int)matches.size();m++){
+            _help_column(index.rows[matches[m]], index.depths[matches[m]], true, &columns[m]);
+            width = std::max(width, columns[m].size());
+        }
+        width += 4;
+
+        out->clear();
+        if (matches.empty()){
+            out->append("No options match '").append(pattern).append("'\n");
+            return;
+        }
+        out->append("Options matching '").append(pattern).append("':\n");
+        for (int m=0;m<(int)matches.size();m++){
+            out->append(columns[m]).append(width-columns[m].size(), ' ');
+            _help_text(index.rows[matches[m]], messages, texts, out);
+            out->append("\n");
+        }
+    }
+
+    //writes all of data to fd, retrying short writes and interrupts
+    int _write_all(int fd, const char* data, size_t size){
+        while (size > 0){
+            ssize_t n = ::write(fd, data, size);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                return ERR_NOT_FOUND;
+            data += n;
+            size -= n;
+        }
+        return ERR_NO_ERR;
+    }
+
+    //the cached help text, rendered again only after the schema changed
+    const std::string& CommandLine::_help(bool full){
+        this->args->finalize();
+        this->_localize();
+        if (this->help.version[full] != this->args->version){
+            _render_help(this->args->root, full, this->messages, &this->args->help_texts, &this->help.text[full]);
+            this->help.version[full] = this->args->version;
         }
+        return this->help.text[full];
+    }
+
+    /**
+     * @brief Prints the usage with a single write(2) to stdout, the text is rendered once per schema version
+     */
+    void CommandLine::printHelp(){
+        const std::string& text = this->_help(false);
+        std::cout.flush();
+        _write_all(STDOUT_FILENO, text.data(), text.size());
     };
 
+    //the usage with dtypes, help messages and choices, see printHelp()
     void CommandLine::printHelpFull(){
-        
-        std::cout << "USAGE:" << std::endl;
-        std::cout << "    Use '-vCLI | --verboseCLI' for more Debug Information\n\n";
-        std::cout << "Required:\n";
-        int indent = 4;
-        for (int i=0;i<this->args->root->arguments.size();i++){ 
-            if (this->args->root->arguments[i]->required){
-                for (int ind=0;ind<indent;ind++)
-                    std::cout << " ";
-                std::cout << "[" << this->args->root->arguments[i]->long_flag << " : ";
-                if (this->args->root->arguments[i]->arguments.size()>0){
-                    for(int k=0;k<this->args->root->arguments[i]->arguments.size();k++){
-                        if (this->args->root->arguments[i]->arguments[k]->required)
-                            std::cout << "<"<<this->args->root->arguments[i]->arguments[k]->long_flag << " : <!" << this->args->root->arguments[i]->arguments[k]->dtype_custom <<">";
-                        else
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag<< " : <" << this->args->root->arguments[i]->arguments[k]->dtype_custom <<">";
-                        if (k<k<this->args->root->arguments[i]->arguments.size()-1)
-                            std::cout << "| ";
-                    }
-                    std::cout << "]\n";
-                }
+        const std::string& text = this->_help(true);
+        std::cout.flush();
+        _write_all(STDOUT_FILENO, text.data(), text.size());
+    };
+
+    /**
+     * @brief Prints only the full help rows whose flags, parameters, help message or choices contain pattern
+     * (case insensitive), what --help=<pattern> shows
+     *
+     * The lookup goes through a trigram index that is built on the first search after a schema change.
+     */
+    void CommandLine::printHelp(const char* pattern){
+        std::vector<int> matches;
+        this->findHelp(pattern, &matches);
+        std::string text;
+        _render_matches(this->help.index, matches, pattern, this->messages, &this->args->help_texts, &text);
+        std::cout.flush();
+        _write_all(STDOUT_FILENO, text.data(), text.size());
+    };
+
+    //the help rows matching pattern, indices into the rows in help order, see printHelp(const char*)
+    int CommandLine::findHelp(const char* pattern, std::vector<int>* matches){
+        this->args->finalize();
+        this->_localize();
+        _help_index& index = this->help.index;
+        if (index.version != this->args->version){
+            index.build(this->args->root, this->messages, &this->args->help_texts);
+            index.version = this->args->version;
+        }
+        index.find(pattern, matches);
+        return matches->size();
+    };
+
+    /**
+     * @brief Where the translated help and error texts are, one binary catalog per locale, %s is the locale
+     *
+     *      cmd.setCatalog("/usr/share/mytool/messages.%s.cat");     //messages.de_DE.cat, then messages.de.cat
+     *
+     * Nothing is opened here, the catalog is memory mapped when help or errorText() is needed the first time.
+     * Untranslated entries fall back to the built in texts. writeCatalog() writes a catalog to start translating from.
+     */
+    void CommandLine::setCatalog(const char* pattern){
+        this->messages.close();
+        this->messages.pattern = pattern != nullptr ? pattern : "";
+        this->help = _help_cache();
+    };
+
+    //the locale of the catalog instead of LC_ALL/LC_MESSAGES/LANG, see setCatalog()
+    void CommandLine::setLocale(const char* locale){
+        this->messages.close();
+        this->messages.locale = locale != nullptr ? locale : "";
+        this->help = _help_cache();
+    };
+
+    //maps the catalog on first use, the rendered help is stale once one was mapped
+    void CommandLine::_localize(){
+        if (this->messages.load())
+            this->help = _help_cache();
+    };
+
+    //the ErrParse() message of an error mask, translated by the catalog if it has it
+    const char* CommandLine::errorText(int err){
+        if (err & ERR_HELP_WILDCARD)
+            return ErrParse(err);
+        int bit = _err_described(err);
+        if (bit == 0)
+            return ErrParse(err);
+        this->_localize();
+        const char* text = this->messages.error(__builtin_ctz(bit));
+        return text != nullptr ? text : ErrParse(err);
+    };
+
+    //the events of the last parse, empty unless compiled with CLI_ENABLE_TRACE
+    const TraceRing& CommandLine::traced(){
+        return this->trace;
+    };
+
+    /**
+     * @brief Writes the trace of the last parse to fd, one line per event with the time since the parse began
+     *
+     *      +   0.412us  match       argv[1] --port
+     *      +   0.530us  param       argv[2] --port <number>
+     *      +   1.874us  parse end   err=1
+     *
+     * Formatted after the parse into one buffer and written at once. Returns ERR_NOT_FOUND if the write failed.
+     */
+    int CommandLine::dumpTrace(int fd){
+        const char* names[] = {"", "parse", "match", "param", "positional", "unknown", "reject", "env", "missing", "rules", "parse end"};
+        std::string out;
+        char line[256];
+        int count = this->trace.count();
+#ifndef CLI_ENABLE_TRACE
+        out.append("<CommandLine::parse> tracing is compiled out, build with -DCLI_ENABLE_TRACE\n");
+#endif
+        if (this->trace.total > (uint32_t)count){
+            snprintf(line, sizeof(line), "... %u earlier events dropped\n", this->trace.total - count);
+            out.append(line);
+        }
+        uint64_t begin = count > 0 ? this->trace.at(0).time : 0;
+        for (int k=0;k<count;k++){
+            const TraceEvent& e = this->trace.at(k);
+            int l = snprintf(line, sizeof(line), "+%10.3fus  %-10s", (e.time-begin)/1000.0, e.event > 0 && e.event <= CLI_EVENT_PARSE_END ? names[e.event] : "?");
+            if (e.argv_index >= 0 && l < (int)sizeof(line))
+                l += snprintf(line+l, sizeof(line)-l, "  argv[%d]", e.argv_index);
+            if (e.id >= 0 && e.id < (int)this->args->by_id.size() && l < (int)sizeof(line)){
+                l += snprintf(line+l, sizeof(line)-l, "  ");
+                if (l < (int)sizeof(line))
+                    l += _argument_name(this->args->by_id[e.id], this->args->root, line+l, sizeof(line)-l);
             }
-            
+            if (e.event == CLI_EVENT_PARSE_BEGIN && l < (int)sizeof(line))
+                l += snprintf(line+l, sizeof(line)-l, "  argc=%d", e.detail);
+            else if (((e.detail & ~ERR_NO_ERR) != 0 || e.event == CLI_EVENT_PARSE_END) && l < (int)sizeof(line))
+                l += snprintf(line+l, sizeof(line)-l, "  err=%d", e.detail);
+            out.append(line).append("\n");
         }
-        std::cout << "Options:\n";
-        indent = 4;
-        for (int i=0;i<this->args->root->arguments.size();i++){ 
-            if (this->args->root->arguments[i]->arg_type | OPTION | WILDCARD){
-                for (int ind=0;ind<indent;ind++)
-                    std::cout << " ";
-                std::cout << (strlen(this->args->root->arguments[i]->short_flag)>1?"-":" ") << (strlen(this->args->root->arguments[i]->short_flag)>0?this->args->root->arguments[i]->short_flag : "   ");
-                for (int p=0;p<4-strlen(this->args->root->arguments[i]->short_flag);p++)
-                    std::cout << " ";
-                std::cout << (this->args->root->arguments[i]->arg_type&(OPTION | WILDCARD)?" |  --" : " >") << this->args->root->arguments[i]->long_flag << ((this->args->root->arguments.size()>0)?" : [":" ");
-                if (this->args->root->arguments[i]->arguments.size()>0){
-                    for(int k=0;k<this->args->root->arguments[i]->arguments.size();k++){
-                        if (this->args->root->arguments[i]->arguments[k]->required)
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag << " : <!" << this->args->root->arguments[i]->arguments[k]->dtype_custom <<">";
-                        else
-                            std::cout << this->args->root->arguments[i]->arguments[k]->long_flag << " : <" << this->args->root->arguments[i]->arguments[k]->dtype_custom <<">";
-                        if (k<k<this->args->root->arguments[i]->arguments.size()-1)
-                            std::cout << "| ";   
-                    }
-                    std::cout << "]\n";
-            
-                }
-                else
-                    std::cout << "]\n";
+        std::cout.flush();
+        return _write_all(fd, out.data(), out.size());
+    };
+
+    //the Options node built for arg by _attach_flat, its key is the interned long flag
+    Options* _options_of(Options* node, const Argument* arg){
+        for (int i=0;i<node->getArgc();i++){
+            Options* child = node->getOption(i);
+            if (child->getKey() == arg->long_flag)
+                return child;
+            Options* found = _options_of(child, arg);
+            if (found != nullptr)
+                return found;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Profile every following parse (and execute) into profile(), off by default
+     *
+     * Passing --cli-profile on the command line profiles that one parse and prints the report afterwards.
+     */
+    void CommandLine::setProfiling(bool on){
+        this->profiling.enabled = on;
+    };
+
+    //timings and counters of the last profiled parse, zero when it was not profiled
+    const ParseProfile& CommandLine::profile(){
+        return this->profiling;
+    };
+
+    /**
+     * @brief Writes the profile of the last parse to fd
+     *
+     *      <CommandLine::parse> 14.208us, 2 allocations (1184 bytes), 37 string compares
+     *        tokenize        1.310us
+     *        match           4.052us
+     *        ...
+     *        slowest validations:
+     *          --port <number>        3.118us   1 value
+     *
+     * Returns ERR_NOT_FOUND if the write failed.
+     */
+    int CommandLine::printProfile(int fd){
+        const char* phases[CLI_PHASE_COUNT] = {"tokenize", "match", "validate", "constraint", "callback"};
+        const ParseProfile& p = this->profiling;
+        std::string out;
+        char line[256];
+        snprintf(line, sizeof(line), "<CommandLine::parse> %.3fus, %llu allocations (%llu bytes), %llu string compares\n", p.total_ns/1000.0, 
+                 (unsigned long long)p.allocations, (unsigned long long)p.allocated_bytes, (unsigned long long)p.string_compares);
+        out.append(line);
+        for (int phase=0;phase<CLI_PHASE_COUNT;phase++){
+            if (phase == CLI_PHASE_CALLBACK)
+                snprintf(line, sizeof(line), "  %-14s%10.3fus  %d run\n", phases[phase], p.phase_ns[phase]/1000.0, p.callbacks);
+            else
+                snprintf(line, sizeof(line), "  %-14s%10.3fus\n", phases[phase], p.phase_ns[phase]/1000.0);
+            out.append(line);
+        }
+        std::vector<int> ids;
+        for (int id=0;id<(int)p.validated.size();id++)
+            if (p.validated[id] > 0)
+                ids.push_back(id);
+        std::sort(ids.begin(), ids.end(), [&p](int a, int b){ return p.validate_ns[a] > p.validate_ns[b]; });
+        if (!ids.empty())
+            out.append("  slowest validations:\n");
+        for (int k=0;k<(int)ids.size() && k<10;k++){
+            char name[128];
+            _argument_name(this->args->by_id[ids[k]], this->args->root, name, sizeof(name));
+            snprintf(line, sizeof(line), "    %-24s%10.3fus  %d value%s\n", name, p.validate_ns[ids[k]]/1000.0, p.validated[ids[k]], p.validated[ids[k]] == 1 ? "" : "s");
+            out.append(line);
+        }
+        std::cout.flush();
+        return _write_all(fd, out.data(), out.size());
+    };
+
+    /**
+     * @brief Runs the callbacks of the parsed options and wildcards and the methods, in command line order
+     *
+     * A method gets the values of its parameters as argc/argv and its node of parsedArgs(). Returns the or'ed
+     * return codes, timed into the callback phase when profiling and appended to the timeline of the parse.
+     */
+    int CommandLine::execute(){
+        ParseProfile* profile = this->profiling.enabled || this->profile_report || this->timeline.enabled ? &this->profiling : nullptr;
+        Timeline* timeline = this->timeline.enabled ? &this->timeline : nullptr;
+        _phase_timer timer(profile, timeline);
+        uint64_t begin = timer.last;
+        uint64_t spent = 0;
+        const ParseResult& r = this->result;
+        int err = ERR_NO_ERR;
+        int last = -1;
+        for (int i=1;i<r.argc;i++){
+            int id = r.owner(i);
+            if (id < 0 || id == last || id >= (int)this->args->by_id.size())
+                continue;
+            last = id;
+            Argument* arg = this->args->by_id[id];
+            timer.restart();
+            if (arg->arg_type&METHOD && arg->method != nullptr){
+                std::vector<char*> values;
+                for (int c=0;c<(int)arg->arguments.size();c++)
+                    if (arg->arguments[c]->arg_type&PARAM && r.has(arg->arguments[c]->id))
+                        values.push_back((char*)r.value(arg->arguments[c]->id));
+                values.push_back(nullptr);
+                err |= arg->method(values.size()-1, values.data(), _options_of(this->parsedArgs(), arg));
+            }else if (arg->arg_type&(OPTION | WILDCARD) && arg->callback != nullptr){
+                err |= arg->callback();
+            }else{
+                continue;
+            }
+            spent += timer.lap(CLI_PHASE_CALLBACK, id);
+            if (profile != nullptr)
+                profile->callbacks++;
+        }
+        if (profile != nullptr)
+            profile->total_ns += spent;
+        if (timeline != nullptr)
+            timeline->add(begin, _now_ns(), CLI_SPAN_EXECUTE, -1);
+        if (this->profile_report){
+            char line[96];
+            int l = snprintf(line, sizeof(line), "<CommandLine::execute> %d run in %.3fus\n", profile->callbacks, profile->phase_ns[CLI_PHASE_CALLBACK]/1000.0);
+            std::cout.flush();
+            _write_all(STDOUT_FILENO, line, l);
+        }
+        return err;
+    };
+
+    /**
+     * @brief Record the phases of every following parse, each validated value and each callback run by execute() as spans
+     *
+     * A parse starts a new timeline, execute() appends to it. Write it with writeTimeline().
+     */
+    void CommandLine::setTimeline(bool on){
+        this->timeline.enabled = on;
+    };
+
+    //appends text as a JSON string body, flags and help names rarely need it but may hold quotes
+    void _json_escaped(const char* text, std::string* out){
+        for (;*text;text++){
+            if (*text == '"' || *text == '\\')
+                out->push_back('\\');
+            if ((unsigned char)*text >= 0x20)
+                out->push_back(*text);
+        }
+    }
+
+    /**
+     * @brief Writes the timeline of the last parse and execute as Chrome trace events, for chrome://tracing or Perfetto
+     *
+     *      {"traceEvents":[
+     *      {"name":"parse","cat":"parse","ph":"X","ts":0.000,"dur":14.208,"pid":4711,"tid":1},
+     *      {"name":"--port <number>","cat":"validate","ph":"X","ts":2.310,"dur":0.842,"pid":4711,"tid":1,"args":{"id":2}},
+     *      ...
+     *
+     * Values of a custom dtype are named "check <parameter>" under the dtype_check_cb category, callbacks and methods
+     * run by execute() are categorized callback and method. Formatted into one buffer and written at once, returns
+     * ERR_NOT_FOUND if the file cannot be written.
+     */
+    int CommandLine::writeTimeline(const char* path){
+        const char* kinds[] = {"tokenize", "match", "validate", "constraint", "callback", "parse", "execute"};
+        const std::vector<TimelineSpan>& spans = this->timeline.spans;
+        uint64_t origin = spans.empty() ? 0 : spans[0].begin;
+        for (int k=1;k<(int)spans.size();k++)
+            origin = std::min(origin, spans[k].begin);
+        int pid = getpid();
+        std::string out("{\"traceEvents\":[\n");
+        char line[160];
+        for (int k=0;k<(int)spans.size();k++){
+            const TimelineSpan& span = spans[k];
+            Argument* arg = span.id >= 0 && span.id < (int)this->args->by_id.size() ? this->args->by_id[span.id] : nullptr;
+            const char* cat = span.kind >= 0 && span.kind <= CLI_SPAN_EXECUTE ? kinds[span.kind] : "?";
+            if (arg != nullptr && span.kind == CLI_PHASE_VALIDATE && arg->is_custom_dtype)
+                cat = "dtype_check_cb";
+            else if (arg != nullptr && span.kind == CLI_PHASE_CALLBACK && arg->arg_type&METHOD)
+                cat = "method";
+            out.append(k == 0 ? "{\"name\":\"" : ",\n{\"name\":\"");
+            if (arg != nullptr){
+                char name[128];
+                _argument_name(arg, this->args->root, name, sizeof(name));
+                if (span.kind == CLI_PHASE_VALIDATE && arg->is_custom_dtype)
+                    out.append("check ");
+                _json_escaped(name, &out);
+            }else{
+                out.append(cat);
+            }
+            snprintf(line, sizeof(line), "\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":1", 
+                     cat, (span.begin-origin)/1000.0, (span.end-span.begin)/1000.0, pid);
+            out.append(line);
+            if (arg != nullptr){
+                snprintf(line, sizeof(line), ",\"args\":{\"id\":%d}", span.id);
+                out.append(line);
             }
-            for (int ind=0;ind<indent;ind++)
-                    std::cout << " ";
-                std::cout << "        -> <" << this->args->root->arguments[i]->help_msg << ">\n\n";
+            out.append("}");
+        }
+        out.append("\n],\"displayTimeUnit\":\"ns\"}\n");
+
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr)
+            return ERR_NOT_FOUND;
+        bool written = fwrite(out.data(), 1, out.size(), file) == out.size();
+        return fclose(file) == 0 && written ? ERR_NO_ERR : ERR_NOT_FOUND;
+    };
+
+    /**
+     * @brief Writes the built in help and error texts as a catalog, the template for a translation
+     *
+     * Help texts are indexed by Argument::id, so a catalog only fits the schema it was written from (and schemas
+     * that add arguments at the end). Returns ERR_NOT_FOUND if the file cannot be written.
+     */
+    int CommandLine::writeCatalog(const char* path){
+        this->args->finalize();
+        int n = this->args->by_id.size();
+        std::vector<char> out(CLI_CATALOG_MAGIC, CLI_CATALOG_MAGIC+8);
+        uint32_t counts[2] = {(uint32_t)n, CLI_CATALOG_ERRORS};
+        out.insert(out.end(), (const char*)counts, (const char*)counts+sizeof(counts));
+        std::vector<uint32_t> offsets(n + CLI_CATALOG_ERRORS, 0);
+        size_t strings = out.size() + 4*offsets.size();
+        std::vector<char> data;
+        //each help text is copied out right away, a decompressed one only lives until the next lookup
+        for (int t=0;t<(int)offsets.size();t++){
+            int bit = t-n;
+            const char* text = t < n ? _help_of(this->args->by_id[t], &this->args->help_texts) :
+                               _err_described(1 << bit) == (1 << bit) ? ErrParse(1 << bit) : nullptr;
+            if (text == nullptr)
+                continue;
+            offsets[t] = strings + data.size();
+            data.insert(data.end(), text, text+strlen(text));
         }
+        out.insert(out.end(), (const char*)offsets.data(), (const char*)(offsets.data()+offsets.size()));
+        out.insert(out.end(), data.begin(), data.end());
+
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr)
+            return ERR_NOT_FOUND;
+        bool written = fwrite(out.data(), 1, out.size(), file) == out.size();
+        return fclose(file) == 0 && written ? ERR_NO_ERR : ERR_NOT_FOUND;
     };
 
 
@@ -893,9 +4361,10 @@ namespace cli
     Options* CommandLine::build_options_tree(){
 
 
+        _free_options(this->options);
         this->options = new Options();
 
-        this->options->setKey(this->args->root->long_flag);
+        this->options->setKeyRef(this->args->root->long_flag);
         this->options->setParsed(true);
         this->options->setArgc(0);
 
@@ -903,84 +4372,699 @@ namespace cli
     }
 
 
+    //resolves every pointer-to-member binding below arg against the destination struct (nullptr clears them), returns how many there are
+    int _resolve_bindings(Argument* arg, void* dst){
+        int members = 0;
+        for (int i=0;i<(int)arg->arguments.size();i++){
+            Argument* child = arg->arguments[i];
+            if (child->binding.resolve != nullptr){
+                child->binding.target = child->binding.resolve(child->binding.member, dst);
+                members++;
+            }
+            members += _resolve_bindings(child, dst);
+        }
+        return members;
+    }
+
+    /**
+     * @brief The hashes of the three ways a token can name a flag: bare (methods), after "-" (short) and after "--" (long)
+     */
+    struct _token_hash
+    {
+        uint32_t                                bare;
+        uint32_t                                single;
+        uint32_t                                dashed;
+
+        _token_hash(const char* tok){
+            this->bare = _hash_flag(tok);
+            this->single = tok[0] == '-' ? _hash_flag(tok+1) : 0;
+            this->dashed = tok[0] == '-' && tok[1] == '-' ? _hash_flag(tok+2) : 0;
+        };
+    };
+
+    /**
+     * @brief Hot index of the flag within hot[begin, begin+count) that tok names, -1 if none does
+     *
+     * Only integer compares on the hot records, the flag strings of the cold Argument are compared on a hash hit
+     */
+    int _match_flag(const argument_tree* tree, int begin, int count, const char* tok, const _token_hash& th, uint64_t* compares){
+        const _hot_arg* hot = tree->hot.data();
+        for (int h=begin;h<begin+count;h++){
+            uint8_t type = hot[h].type_bits;
+            if (type&(OPTION | WILDCARD) && tok[0] == '-'){
+                if (tok[1] == '-' && hot[h].long_hash == th.dashed && (++*compares, _compare_cstring(tok+2, tree->by_id[hot[h].id]->long_flag)))
+                    return h;
+                if (hot[h].short_hash == th.single && (++*compares, _compare_cstring(tok+1, tree->by_id[hot[h].id]->short_flag)))
+                    return h;
+            }
+            if (type&METHOD && (hot[h].long_hash == th.bare || hot[h].short_hash == th.bare)){
+                Argument* arg = tree->by_id[hot[h].id];
+                *compares += 2;
+                if (_compare_cstring(tok, arg->long_flag) || _compare_cstring(tok, arg->short_flag))
+                    return h;
+            }
+        }
+        return -1;
+    }
+
+    //the tokens the parser handles itself: -vCLI, --verboseCLI, -h, --help, --help=<pattern> and --cli-profile
+    bool _is_cli_wildcard(const char* tok, uint64_t* compares){
+        if (tok[0] != '-')
+            return false;
+        *compares += 6;
+        return _compare_cstring(tok, "-vCLI") || _compare_cstring(tok, "--verboseCLI") || _compare_cstring(tok, "-h") || 
+               _compare_cstring(tok, "--help") || strncmp(tok, "--help=", 7) == 0 || _compare_cstring(tok, "--cli-profile");
+    }
+
+    //the flag tok matches in scope or any enclosing scope up to the root, -1 for none
+    int _match_scoped(const argument_tree* tree, int scope, const char* tok, const _token_hash& th, uint64_t* compares){
+        const _hot_arg* hot = tree->hot.data();
+        int m = -1;
+        for (int s = scope;m < 0;s = hot[s].parent){
+            m = s < 0 ? _match_flag(tree, 0, tree->root_count, tok, th, compares) : _match_flag(tree, hot[s].child_begin, hot[s].child_count, tok, th, compares);
+            if (s < 0)
+                break;
+        }
+        return m;
+    }
+
+    //the first positional parameter within hot[begin, begin+count), that still takes tok
+    int _match_positional(const argument_tree* tree, int begin, int count, const ParseResult& result, char* tok){
+        const _hot_arg* hot = tree->hot.data();
+        for (int h=begin;h<begin+count;h++)
+            if (hot[h].type_bits&PARAM && !result.has(hot[h].id) && parseArg(tree->by_id[hot[h].id], tok) == ERR_NO_ERR)
+                return h;
+        return -1;
+    }
+
+    //writes the value into the arguments binding, flags without parameters pass nullptr
+    int _store_binding(Argument* arg, const char* value){
+        if (arg->binding.store == nullptr || arg->binding.target == nullptr)
+            return ERR_NO_ERR;
+        int e = arg->binding.store(arg->binding.target, arg->arg_type&PARAM ? value : nullptr);
+        return e == ERR_NO_ERR ? ERR_NO_ERR : e | ERR_NO_ERR;
+    }
+
+    //decodes, checks and binds a value for _accept_value(), check and offset describe an ERR_OUT_OF_RANGE
+    int _take_value(Argument* arg, const char* value, ParseResult* result, ListValues* lists, int* check, int* offset){
+        if (arg->choice_count > 0)
+            result->_choice_ids()[arg->id] = _choice_index(arg, value)+1;
+        if (arg->dtype >= CLI_DTYPE_INT_LIST && arg->dtype <= CLI_DTYPE_STRING_LIST){
+            int e = lists->_decode(arg, value, check, offset);
+            if (e != ERR_NO_ERR)
+                return e;
+        }
+        if (arg->arg_type&PARAM && !arg->is_custom_dtype){
+            _typed_value* typed = &result->_typed()[arg->id];
+            if (_decode_typed(arg->dtype, value, typed) == ERR_WRONG_DATA)
+                return ERR_WRONG_DATA;
+            if ((*check = _check_constraint(arg->constraint, arg->dtype, *typed)) != 0)
+                return ERR_OUT_OF_RANGE;
+            char text[32];
+            const char* decoded = _typed_text(arg->dtype, *typed, text, sizeof(text));
+            if (decoded != nullptr)
+                return _store_binding(arg, decoded);
+        }
+        return _store_binding(arg, value);
+    }
+
+    /**
+     * @brief Takes a value the parser matched to arg: typed dtypes are decoded into the result, list dtypes into lists,
+     * then the binding is written (with the decoded value for typed dtypes)
+     *
+     * A value that does not decode returns ERR_WRONG_DATA alone, one violating a constraint ERR_OUT_OF_RANGE alone (the
+     * value is rejected), a failing binding keeps ERR_NO_ERR. Every failure is reported in the result at argv[at],
+     * at is -1 for a value from the environment.
+     */
+    int _accept_value(Argument* arg, const char* value, int at, ParseResult* result, ListValues* lists){
+        int check = 0;
+        int offset = 0;
+        int e = _take_value(arg, value, result, lists, &check, &offset);
+        if (e & ~ERR_NO_ERR)
+            result->_report(e & ~ERR_NO_ERR, at, offset, arg->id, check, value);
+        return e;
+    }
+
+    /**
+     * @brief Feeds the environment value of an absent flag through the same checks as a value from argv
+     *
+     * A flag with parameters passes the value to its first parameter, a plain flag reads it as a boolean
+     * (1/true/yes/on), everything else is treated as if the flag was not given at all.
+     */
+    int _apply_env(Argument* arg, ParseResult* result, ListValues* lists){
+        char* value = arg->env_value;
+        Argument* param = nullptr;
+        if (!(arg->arg_type&PARAM))
+            for (int i=0;i<(int)arg->arguments.size() && param == nullptr;i++)
+                if (arg->arguments[i]->arg_type&PARAM)
+                    param = arg->arguments[i];
+
+        if (arg->arg_type&PARAM || param != nullptr){
+            if (parseArg(param != nullptr ? param : arg, value) != ERR_NO_ERR){
+                result->_report(ERR_WRONG_DATA, -1, 0, param != nullptr ? param->id : arg->id, 0, value);
+                return ERR_WRONG_DATA;
+            }
+        }else{
+            bool on;
+            if (_decode_bool(value, &on) != ERR_NO_ERR){
+                result->_report(ERR_WRONG_DATA, -1, 0, arg->id, 0, value);
+                return ERR_WRONG_DATA;
+            }
+            if (!on)
+                return ERR_NO_ERR;
+        }
+        int err = ERR_NO_ERR;
+        result->_mark(arg->id, CLI_SOURCE_ENV);
+        result->_env()[arg->id] = value;
+        err |= _accept_value(arg, value, -1, result, lists);
+        if (param != nullptr){
+            result->_mark(param->id, CLI_SOURCE_ENV);
+            result->_env()[param->id] = value;
+            err |= _accept_value(param, value, -1, result, lists);
+        }
+        return err;
+    }
+
+    //builds the Options node of every present argument below arg
+    void _attach_flat(Argument* arg, const ParseResult& result, Options* node){
+        for (int i=0;i<(int)arg->arguments.size();i++){
+            Argument* child = arg->arguments[i];
+            if (!result.has(child->id))
+                continue;
+            Options* nop = new Options();
+            nop->setParsed(true);
+            nop->setData((char*)result.value(child->id));
+            nop->setArgType(child->arg_type);
+            nop->setKeyRef(child->long_flag);
+            node->setArgc(node->getArgc()+1);
+            node->addOptions(nop);
+            _attach_flat(child, result, nop);
+        }
+    }
+
+    //member bindings (Argument::bind(&S::field)) need the destination of parse(argc, argv, &dst), ERR_NOT_FOUND without
     int CommandLine::parse(int argc, char **argv)
     {
-        Options* options_tree = this->build_options_tree();
+        if (_resolve_bindings(this->args->root, nullptr) > 0)
+            return ERR_NOT_FOUND;
+        this->result.detach();
+        return this->_parse(argc, argv, false);
+    }
+
+    int CommandLine::parseInto(int argc, char **argv, void* dst)
+    {
+        _resolve_bindings(this->args->root, dst);
+        this->result.detach();
+        return this->_parse(argc, argv, false);
+    }
+
+    /**
+     * @brief Parse without touching the heap, the result lives in storage and is read through parsed()
+     *
+     * Nothing is printed (-h only sets ERR_HELP_WILDCARD, call printHelp() yourself) and no Options tree is built.
+     * Storage smaller than storageFor(argc) fails with ERR_CAPACITY instead of allocating. Call storageFor() once
+     * after the last schema change, it compiles the schema and reserves the list buffers up front so the parse itself
+     * stays allocation free.
+     * Bindings to std::string still allocate like any std::string assignment, bind const char* instead. Member bindings
+     * have no destination here, ERR_NOT_FOUND like parse(argc, argv).
+     */
+    int CommandLine::parse(int argc, char **argv, void* storage, int bytes)
+    {
+        if (_resolve_bindings(this->args->root, nullptr) > 0)
+            return ERR_NOT_FOUND;
+        this->result.attach(storage, bytes);
+        return this->_parse(argc, argv, true);
+    }
+
+    /**
+     * @brief Bytes of storage for parsing argc tokens, also compiles the schema and reserves the list buffers
+     *
+     * With argv the list buffers fit exactly these tokens, without they fit tokens of up to CLI_LIST_RESERVE_CHARS
+     * characters, longer list values allocate on their first parse.
+     */
+    int CommandLine::storageFor(int argc, char** argv)
+    {
+        this->args->finalize();
+        this->_reserve_lists(argc, argv);
+        return ParseResult::sizeFor(this->args->by_id.size(), argc) + 8;
+    }
+
+    //reserves the ListValues for argv (or argc estimated tokens) plus one environment value per list parameter
+    void CommandLine::_reserve_lists(int argc, char** argv){
+        const argument_tree* tree = this->args;
+        if (tree->list_dtypes == 0)
+            return;
+        int chars = tree->list_params*CLI_LIST_RESERVE_CHARS;
+        for (int i=0;i<argc;i++)
+            chars += argv != nullptr ? strlen(argv[i]) : CLI_LIST_RESERVE_CHARS;
+        this->list_values._reserve(tree->by_id.size(), tree->list_dtypes, argc+tree->list_params, chars);
+    }
+
+    /**
+     * @brief The single pass over argv
+     *
+     * Every token is matched against the flags of the current scope (the root, or the last matched method, then its
+     * parents), followed by the parameters of the matched flag in declaration order. Tokens matching no flag fill free
+     * positional parameters of the scope. Everything is recorded in the flat ParseResult, bindings are written on match.
+     */
+    int CommandLine::_parse(int argc, char **argv, bool quiet)
+    {
+        this->frozen.release();
+        _free_options(this->options);
+        this->options = nullptr;
         int help=0;
+        uint64_t compares = 0;
+        this->profile_report = false;
+        for (int i = 0; i < argc && !this->profile_report; i++)
+            this->profile_report = _compare_cstring(argv[i], "--cli-profile");
+        compares += argc;
+        ParseProfile* profile = this->profiling.enabled || this->profile_report || this->timeline.enabled ? &this->profiling : nullptr;
+        Timeline* timeline = this->timeline.enabled ? &this->timeline : nullptr;
+        this->profiling.reset(profile != nullptr ? this->args->by_id.size() : 0);
+        uint64_t begin = profile != nullptr ? _now_ns() : 0;
+        uint64_t started = begin;
+        if (timeline != nullptr)
+            timeline->spans.clear();
+        _phase_timer timer(profile, timeline);
         //check for verbosity
         for (int i = 0; i < argc; i++)
         {
+            compares += 5;
             if (_compare_cstring(argv[i], "-vCLI") || _compare_cstring(argv[i], "--verboseCLI")){
                 this->verbosity = VERBOSE_FULL;
             }
-             if (_compare_cstring(argv[i], "-h") || _compare_cstring(argv[i], "--help")){
-                this->printHelpFull();
-                help = ERR_HELP_WILDCARD;
+             if (_compare_cstring(argv[i], "-h") || _compare_cstring(argv[i], "--help")){
+                if (!quiet)
+                    this->printHelpFull();
+                help = ERR_HELP_WILDCARD;
+            }
+            //--help=<pattern> only shows the matching options
+            if (strncmp(argv[i], "--help=", 7) == 0){
+                if (!quiet)
+                    this->printHelp(argv[i]+7);
+                help = ERR_HELP_WILDCARD;
+            }
+        }
+
+#ifndef CLI_ENABLE_TRACE
+        //without tracing compiled in -vCLI prints while parsing, as it always did
+        if (this->verbosity>=VERBOSE_SIMPLE && !quiet){
+            if (argc>=0){
+                std::cout << "******************\nRunning the CommandLine : (" << argv[0] <<")\n******************\n";
+            }
+            std::cout << "<CommandLine::parse(int argc, char **argv)>"<< std::endl;
+        }
+#endif
+        int err=ERR_NO_ERR;
+        //with CLI_ENABLE_TRACE nothing is printed while parsing, -vCLI dumps the trace of the parse afterwards
+        this->trace.reset();
+        CLI_TRACE(this->trace, CLI_EVENT_PARSE_BEGIN, -1, -1, argc);
+
+        //compiling a changed schema is not part of any phase
+        timer.lap(CLI_PHASE_TOKENIZE);
+        this->args->finalize();
+        int count = this->args->by_id.size();
+        if (profile != nullptr && (int)profile->validate_ns.size() != count)
+            profile->reset(count);
+        begin += timer.restart();
+        char* block = this->result.block;
+        if (this->result.reset(count, argc) != ERR_NO_ERR)
+            return ERR_CAPACITY;
+        if (profile != nullptr && this->result.block != block){
+            profile->allocations++;
+            profile->allocated_bytes += this->result.capacity;
+        }
+        uint64_t list_bytes;
+        int list_vectors = this->list_values._capacity(&list_bytes);
+        this->list_values._reset();
+        this->_reserve_lists(argc, argv);
+        ParseResult* r = &this->result;
+        Argument* root = this->args->root;
+
+        const argument_tree* tree = this->args;
+        const _hot_arg* hot = tree->hot.data();
+        int scope = -1;     //hot index of the last matched method, -1 for the root
+        for (int i=1;i<argc;){
+            _token_hash th(argv[i]);
+            int m = _match_scoped(tree, scope, argv[i], th, &compares);
+
+            if (m < 0){
+                int positional = -1;
+                for (int s = scope;positional < 0;s = hot[s].parent){
+                    positional = s < 0 ? _match_positional(tree, 0, tree->root_count, *r, argv[i]) : _match_positional(tree, hot[s].child_begin, hot[s].child_count, *r, argv[i]);
+                    if (s < 0)
+                        break;
+                }
+                timer.lap(CLI_PHASE_MATCH);
+                if (positional >= 0){
+                    int accepted = _accept_value(tree->by_id[hot[positional].id], argv[i], i, r, &this->list_values);
+                    timer.validated(hot[positional].id);
+                    CLI_TRACE(this->trace, accepted == ERR_NO_ERR ? CLI_EVENT_POSITIONAL : CLI_EVENT_REJECT, hot[positional].id, i, accepted);
+                    //like a flag parameter, a rejected value leaves the positional absent (and still missing if required)
+                    if (accepted&ERR_NO_ERR)
+                        r->_consume(hot[positional].id, i);
+                    err |= accepted;
+                }else if (!_is_cli_wildcard(argv[i], &compares)){
+                    err |= ERR_UNKOWN_INPUT;
+                    r->_report(ERR_UNKOWN_INPUT, i, 0, -1, 0, argv[i]);
+                    CLI_TRACE(this->trace, CLI_EVENT_UNKNOWN, -1, i, ERR_UNKOWN_INPUT);
+                }
+                i++;
+                continue;
+            }
+
+            int id = hot[m].id;
+            CLI_TRACE(this->trace, CLI_EVENT_MATCH, id, i, 0);
+#ifndef CLI_ENABLE_TRACE
+            if (this->verbosity>=VERBOSE_FULL && !quiet)
+                std::cout << "Matched the Argument: "<< tree->by_id[id]->long_flag <<std::endl;
+#endif
+            if (r->occurrences(id) > 0 && _HOT_REPEAT(hot[m].type_bits) == CLI_REPEAT_ERROR){
+                err |= ERR_REPEATED;
+                r->_report(ERR_REPEATED, i, 0, id, 0, argv[i]);
+            }
+            r->_consume(id, i);
+            r->_occurrences()[id]++;
+            err |= _store_binding(tree->by_id[id], argv[i]);
+            i++;
+
+            //the parameters of the flag follow in declaration order
+            for (int c=hot[m].child_begin;c<hot[m].child_begin+hot[m].child_count;c++){
+                if (!(hot[c].type_bits&PARAM))
+                    continue;
+                if (i >= argc)
+                    continue;
+                //a dash starts the next flag, unless it is a negative number for a numeric parameter and no flag is named so
+                if (argv[i][0] == '-' && argv[i][1] != '\0' && 
+                    !(_negative_value(hot[c].dtype, argv[i]) && _match_scoped(tree, scope, argv[i], _token_hash(argv[i]), &compares) < 0))
+                    continue;
+                Argument* param = tree->by_id[hot[c].id];
+                timer.lap(CLI_PHASE_MATCH);
+                int accepted = ERR_WRONG_DATA;
+                if (parseArg(param, argv[i]) == ERR_NO_ERR)
+                    accepted = _accept_value(param, argv[i], i, r, &this->list_values);
+                else
+                    r->_report(ERR_WRONG_DATA, i, 0, param->id, 0, argv[i]);
+                timer.validated(hot[c].id);
+                CLI_TRACE(this->trace, accepted == ERR_NO_ERR ? CLI_EVENT_PARAM : CLI_EVENT_REJECT, hot[c].id, i, accepted);
+                if (!(accepted&ERR_NO_ERR)){
+                    err |= accepted;
+                    i++;
+                    continue;
+                }
+                r->_consume(hot[c].id, i);
+                r->_occurrences()[hot[c].id]++;
+                err |= accepted;
+                i++;
             }
+            if (hot[m].type_bits&METHOD)
+                scope = m;
+            timer.lap(CLI_PHASE_MATCH);
         }
 
-        if (this->verbosity>=VERBOSE_SIMPLE){
-            if (argc>=0){
-                std::cout << "******************\nRunning the CommandLine : (" << argv[0] <<")\n******************\n";
+        //one pass over environ for all declared environment fallbacks of absent flags, in storage reserved by finalize()
+        std::vector<Argument*>& declared = this->args->env_declared;
+        declared.clear();
+        _collect_env(root, &declared);
+        if (declared.size()>0){
+            _env_index& index = this->args->env_index;
+            index.build(declared);
+            index.scan(environ);
+            for (int d=0;d<(int)declared.size();d++)
+                if (declared[d]->env_value != nullptr && !r->has(declared[d]->id)){
+                    CLI_TRACE(this->trace, CLI_EVENT_ENV, declared[d]->id, -1, 0);
+                    err |= _apply_env(declared[d], r, &this->list_values);
+                }
+        }
+        r->_finish(argv);
+        if (this->args->list_dtypes != 0)
+            this->list_values._finish(count);
+        for (int h=0;h<(int)tree->hot.size();h++)
+            if (_HOT_REPEAT(hot[h].type_bits) == CLI_REPEAT_LAST || _HOT_REPEAT(hot[h].type_bits) == CLI_REPEAT_COUNT){
+                r->_keep_last(hot[h].id);
+                if (this->args->list_dtypes != 0)
+                    this->list_values._keep_last(hot[h].id);
+            }
+
+        //required arguments in O(words), a required parameter only counts when its flag was given
+        const uint64_t* present = r->_present();
+        uint64_t* missing = r->_missing();
+        for (int w=0;w<r->words;w++){
+            uint64_t absent = tree->required[w] & ~present[w];
+            for (uint64_t todo = absent;todo != 0;todo &= todo-1){
+                int id = w*64 + __builtin_ctzll(todo);
+                int parent = tree->parent_id[id];
+                if (parent >= 0 && !((present[parent>>6] >> (parent&63)) & 1)){
+                    absent &= ~((uint64_t)1 << (id&63));
+                    continue;
+                }
+                int kind = tree->by_id[id]->arg_type&PARAM ? ERR_REQ_PARAM_NOT_FOUND : ERR_REQ_ARG_NOT_FOUND;
+                err |= kind;
+                CLI_TRACE(this->trace, CLI_EVENT_MISSING, id, -1, kind);
+                //a missing parameter points at its flag
+                r->_report(kind, parent >= 0 ? r->valueIndex(parent, r->valueCount(parent)-1) : -1, 0, id, 0, nullptr);
             }
+            missing[w] = absent;
         }
-        int err=0;
 
+        int first_rule = r->diagnostic_count;
+        int ruled = this->args->checkRules(r->_present(), r->diagnostics, CLI_MAX_DIAGNOSTICS, &r->diagnostic_count);
+        CLI_TRACE(this->trace, CLI_EVENT_RULES, -1, -1, ruled);
+        err |= ruled;
+        for (int d=first_rule;d<r->diagnostic_count && d<CLI_MAX_DIAGNOSTICS;d++)
+            if (r->diagnostics[d].id >= 0)
+                r->diagnostics[d].argv_index = r->valueIndex(r->diagnostics[d].id);
+        timer.lap(CLI_PHASE_CONSTRAINT);
+
+        CLI_TRACE(this->trace, CLI_EVENT_PARSE_END, -1, -1, err | help);
+        if (profile != nullptr){
+            uint64_t bytes;
+            int vectors = this->list_values._capacity(&bytes);
+            if (bytes > list_bytes){
+                profile->allocations += vectors > list_vectors ? vectors-list_vectors : 1;
+                profile->allocated_bytes += bytes-list_bytes;
+            }
+            profile->string_compares = compares;
+            profile->total_ns = _now_ns() - begin;
+        }
+        if (timeline != nullptr)
+            timeline->add(started, _now_ns(), CLI_SPAN_PARSE, -1);
+#ifdef CLI_ENABLE_TRACE
+        if (this->verbosity>=VERBOSE_SIMPLE && !quiet)
+            this->dumpTrace(STDOUT_FILENO);
+#else
+        if (this->verbosity>=VERBOSE_SIMPLE && !quiet)
+            std::cout << "<Finished parsing, start cleaning>"<< std::endl;
+#endif
+        if (this->profile_report && !quiet)
+            this->printProfile(STDOUT_FILENO);
 
-        if (this->verbosity>=VERBOSE_SIMPLE)
-            std::cout << "<CommandLine::parse(int argc, char **argv)>"<< std::endl;
+        if (err== ERR_NO_ERR || help){
+            err |= help;
 
-        char** newargv= copySubArgv(argc, argv, 1);
-        //run over all top level arguments, run recursive into each branch checking wether the argument parsing was successful
-        for (int a=0;a<this->args->root->getArguments().size();a++){
-            Argument* arg = this->args->root->getArguments()[a];
-            if (this->verbosity>=VERBOSE_FULL)
-                std::cout << "Parsing recursively the Argument: "<< arg->long_flag <<std::endl;
-            
-            err |= arg->parse(argc, argv, options_tree) | err;
-            if (!arg->required && !(err&ERR_REQ_PARAM_NOT_FOUND)){
-                 err = err & ~ERR_REQ_ARG_NOT_FOUND;   
+        }else if (!quiet){
+            //every recorded problem on its own line, then the usage
+            char message[256];
+            for (int d=0;d<r->diagnostic_count && d<CLI_MAX_DIAGNOSTICS;d++){
+                this->describe(d, message, sizeof(message));
+                std::cout << message << std::endl;
             }
-            if (arg->required && arg->arg_type&PARAM)
-                err |=ERR_REQ_PARAM_NOT_FOUND;
-       
+            if (r->diagnostic_count > CLI_MAX_DIAGNOSTICS)
+                std::cout << "... and " << r->diagnostic_count-CLI_MAX_DIAGNOSTICS << " more" << std::endl;
+            this->printHelp();
         }
+        return err;
+    };
 
-        if (this->verbosity>=VERBOSE_SIMPLE)
-            std::cout << "<Finished parsing, start cleaning>"<< std::endl;
 
+    /**
+     * @brief The config file read by merge(), one "key = value" per line, '#' starts a comment
+     *
+     * Keys are long flags ("port = 80" feeds the first parameter of --port) or "flag.param" for a specific parameter
+     */
+    void CommandLine::setConfigFile(const char* path){
+        this->config_file = new char[strlen(path)];
+        write_string(this->config_file, (char*)path);
+    };
 
-        //std::cout << err << std::endl;
+    const char* CommandLine::getConfigFile(){
+        return this->config_file;
+    };
 
-        if (err== ERR_NO_ERR || help){
-            err |= help;
-                //TODO store all the values in an option contianer and parse everything 
+    //finds the argument named by a config file key, either "flag" or "flag.param"
+    Argument* _find_config_key(Argument* root, const char* key, int l){
+        for (int i=0;i<(int)root->arguments.size();i++){
+            Argument* arg = root->arguments[i];
+            int fl = strlen(arg->long_flag)-1;
+            if (fl > l || !_compare_cstring_until(arg->long_flag, (char*)key, fl))
+                continue;
+            if (fl == l)
+                return arg;
+            if (key[fl] == '.'){
+                Argument* child = _find_config_key(arg, key+fl+1, l-fl-1);
+                if (child != nullptr)
+                    return child;
+            }
+        }
+        return nullptr;
+    }
 
-        }else{
-            char* errmsg;
+    /**
+     * @brief Reads the config file into one buffer and cuts it in place into per argument values (file_values[id])
+     */
+    int _read_config_file(const char* path, Argument* root, Config* config, std::vector<const char*>* file_values){
+        FILE* f = fopen(path, "rb");
+        if (f == nullptr)
+            return ERR_CONFIG_FILE;
+        long size = fseek(f, 0, SEEK_END) == 0 ? ftell(f) : -1;
+        if (size < 0 || fseek(f, 0, SEEK_SET) != 0){
+            fclose(f);
+            return ERR_CONFIG_FILE;
+        }
+        free(config->file_data);
+        config->file_data = (char*)malloc(size+1);
+        if (config->file_data == nullptr){
+            fclose(f);
+            return ERR_CONFIG_FILE;
+        }
+        size = fread(config->file_data, 1, size, f);
+        fclose(f);
+        config->file_data[size] = '\0';
+
+        int err = ERR_NO_ERR;
+        char* line = config->file_data;
+        while (*line != '\0'){
+            char* end = line;
+            while (*end != '\0' && *end != '\n')
+                end++;
+            char* next = *end == '\0' ? end : end+1;
+            *end = '\0';
+
+            char* key = line;
+            while (*key == ' ' || *key == '\t')
+                key++;
+            char* eq = key;
+            while (*eq != '\0' && *eq != '=')
+                eq++;
+            if (*key != '#' && *key != '\0' && *key != '\r'){
+                if (*eq != '='){
+                    err |= ERR_CONFIG_FILE;
+                    line = next;
+                    continue;
+                }
+                char* key_end = eq;
+                while (key_end > key && (key_end[-1] == ' ' || key_end[-1] == '\t'))
+                    key_end--;
+                char* value = eq+1;
+                while (*value == ' ' || *value == '\t')
+                    value++;
+                char* value_end = end;
+                while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t' || value_end[-1] == '\r'))
+                    value_end--;
+                if (value_end-value >= 2 && *value == '"' && value_end[-1] == '"'){
+                    value++;
+                    value_end--;
+                }
+                *value_end = '\0';
+
+                Argument* arg = _find_config_key(root, key, key_end-key);
+                if (arg == nullptr || arg->id < 0){
+                    *key_end = '\0';
+                    config->unknown.push_back(key);
+                }else{
+                    (*file_values)[arg->id] = value;
+                    //"flag.param = value" sets the flag as well, "flag = value" feeds its first parameter
+                    if (arg->arg_type&PARAM && arg->parent != nullptr && arg->parent->id >= 0 && (*file_values)[arg->parent->id] == nullptr)
+                        (*file_values)[arg->parent->id] = value;
+                    if (!(arg->arg_type&PARAM))
+                        for (int q=0;q<(int)arg->arguments.size();q++)
+                            if (arg->arguments[q]->arg_type&PARAM){
+                                (*file_values)[arg->arguments[q]->id] = value;
+                                break;
+                            }
+                }
+            }
+            line = next;
+        }
+        return err;
+    }
 
+    /**
+     * @brief Merges defaults < config file < environment < argv into one flat, typed Config
+     *
+     * The argv and environment layers are taken from the last parse(), the config file is read on every call.
+     * Keys of the file that name no argument end up in Config::unknown, the rest of the file still applies.
+     * Given multiple times on the commandline, the last occurrence wins.
+     * Resolution is a single pass over the dense argument ids.
+     */
+    int CommandLine::merge(Config* config){
+        this->args->assignIds(this->args->root);
+        int n = this->args->by_id.size();
+        std::vector<const char*> file_values(n, nullptr);
+
+        int err = ERR_NO_ERR;
+        config->unknown.clear();
+        if (this->config_file != nullptr)
+            err |= _read_config_file(this->config_file, this->args->root, config, &file_values);
+
+        config->entries.assign(n, ConfigEntry{nullptr, 0, 0.0, CLI_SOURCE_NONE});
+        for (int id=0;id<n;id++){
+            Argument* arg = this->args->by_id[id];
+            ConfigEntry* entry = &config->entries[id];
+
+            if (this->result.has(id)){
+                entry->value = this->result.value(id, this->result.valueCount(id)-1);
+                entry->source = this->result.source(id);
+            }else if (file_values[id] != nullptr){
+                entry->value = file_values[id];
+                entry->source = CLI_SOURCE_FILE;
+            }else if (arg->default_value != nullptr){
+                entry->value = arg->default_value;
+                entry->source = CLI_SOURCE_DEFAULT;
+            }
+            if (entry->value == nullptr)
+                continue;
 
-            if (err & ERR_UNKOWN_INPUT || err & ERR_INVALID_INPUT){
-                //PRINT HELP
-                this->printHelp();
+            if (!(arg->arg_type&PARAM)){
+                bool on = true;
+                if (entry->source == CLI_SOURCE_FILE || entry->source == CLI_SOURCE_DEFAULT)
+                    if (_decode_bool(entry->value, &on) != ERR_NO_ERR && arg->arguments.size() == 0)
+                        err |= ERR_WRONG_DATA;
+                entry->integer = on;
+                entry->real = on;
+                continue;
+            }
+            //argv and environment values were already checked by the parser
+            if (entry->source <= CLI_SOURCE_FILE && parseArg(arg, (char*)entry->value) != ERR_NO_ERR){
+                err |= ERR_WRONG_DATA;
+                continue;
             }
-            if (err & ERR_REQ_ARG_NOT_FOUND){
-                //scan for required argument and print the errro to console
-                this->printHelp();
+            //choices of a non numeric parameter come out as their index
+            if (arg->choice_count > 0 && _dtype_kind(arg->dtype) == 0){
+                entry->integer = _choice_index(arg, entry->value);
+                entry->real = (double)entry->integer;
             }
-            if (err & ERR_WRONG_DATA){
-                this->printHelp();
+            _typed_value typed;
+            if (arg->is_custom_dtype || _decode_typed(arg->dtype, entry->value, &typed) != ERR_NO_ERR)
+                continue;
+            if (_check_constraint(arg->constraint, arg->dtype, typed) != 0){
+                err |= ERR_OUT_OF_RANGE;
+                continue;
+            }
+            if (arg->dtype == CLI_DTYPE_DOUBLE){
+                entry->real = typed.real;
+                entry->integer = (long long)typed.real;
+            }else if (arg->dtype == CLI_DTYPE_UINT64 || arg->dtype == CLI_DTYPE_SIZE || arg->dtype == CLI_DTYPE_PORT){
+                entry->integer = (long long)typed.uinteger;
+                entry->real = (double)typed.uinteger;
+            }else if (arg->dtype != CLI_DTYPE_IPV4 && arg->dtype != CLI_DTYPE_IPV6){
+                entry->integer = typed.integer;
+                entry->real = (double)typed.integer;
             }
-
         }
-        for (int q=0;q<argc-1;q++)
-                    free(newargv[q]);
-
-                free(newargv);
         return err;
     };
 
-
     Argument* CommandLine::operator[](char *key)
     {
 
@@ -993,9 +5077,123 @@ namespace cli
     */
     Options* CommandLine::parsedArgs()
     {
+        if (this->options == nullptr){
+            this->build_options_tree();
+            _attach_flat(this->args->root, this->result, this->options);
+        }
         return this->options;
     }
 
+    /**
+    *   The flat result of the last parse, indexed by Argument::id
+    *
+    */
+    /**
+     * @brief Formats diagnostic index of the last parse (parsed().diagnostics) as one line into buffer
+     *
+     *      argv[3]: unknown argument "--prot"
+     *      argv[2]: --port <number>: 70000 is above the maximum 65535
+     *      argv[4]+6: --ids <list>: 1,2,99 is above the maximum 10
+     *      --input is required
+     *      argv[1]: --json conflicts with --yaml
+     *      one of --file, --url is required
+     *
+     * argv[i]+n points n bytes into the token. Nothing is formatted while parsing, only here.
+     * Returns the length like snprintf, 0 (and an empty buffer) for an index without a diagnostic.
+     */
+    int CommandLine::describe(int index, char* buffer, int size)
+    {
+        if (size > 0)
+            buffer[0] = '\0';
+        const ParseResult& r = this->result;
+        if (index < 0 || index >= r.diagnostic_count || index >= CLI_MAX_DIAGNOSTICS)
+            return 0;
+        const Diagnostic& d = r.diagnostics[index];
+        const std::vector<Argument*>& by_id = this->args->by_id;
+        Argument* arg = d.id >= 0 && d.id < (int)by_id.size() ? by_id[d.id] : nullptr;
+        char name[128] = "";
+        if (arg != nullptr)
+            _argument_name(arg, this->args->root, name, sizeof(name));
+        const char* text = d.text != nullptr ? d.text : "";
+
+        int l = 0;
+        if (d.argv_index >= 0)
+            l = d.offset > 0 ? snprintf(buffer, size, "argv[%d]+%d: ", d.argv_index, d.offset) : snprintf(buffer, size, "argv[%d]: ", d.argv_index);
+        if (l >= size)
+            return l;
+        buffer += l;
+        size -= l;
+
+        if (d.kind & ERR_UNKOWN_INPUT)
+            return l + snprintf(buffer, size, "unknown argument \"%s\"", text);
+        if (d.kind & ERR_REPEATED)
+            return l + snprintf(buffer, size, "%s is given more than once", name);
+        if (d.kind & ERR_WRONG_DATA)
+            return l + snprintf(buffer, size, "%s: \"%s\" is not a valid %s", name, text, arg == nullptr ? "value" : arg->is_custom_dtype && arg->dtype_custom != nullptr ? arg->dtype_custom : _dtype_name(arg->dtype));
+        if (d.kind & (ERR_REQ_ARG_NOT_FOUND | ERR_REQ_PARAM_NOT_FOUND))
+            return l + snprintf(buffer, size, "%s is required", name);
+        if (d.detail == CLI_RULE_EXCLUSIVE && d.kind & ERR_CONFLICT)
+            return l + snprintf(buffer, size, "--%s conflicts with --%s", by_id[d.id]->long_flag, by_id[d.other]->long_flag);
+        if (d.detail == CLI_RULE_REQUIRES && d.kind & ERR_DEPENDENCY)
+            return l + snprintf(buffer, size, "--%s requires --%s", by_id[d.id]->long_flag, by_id[d.other]->long_flag);
+        if (d.detail == CLI_RULE_ONE_OF && d.kind & ERR_DEPENDENCY){
+            const std::vector<Argument*>& members = this->args->rules[d.other].members;
+            int k = snprintf(buffer, size, "one of");
+            for (int m=0;m<(int)members.size() && k < size;m++)
+                k += snprintf(buffer+k, size-k, "%s --%s", m > 0 ? "," : "", members[m]->long_flag);
+            if (k < size)
+                k += snprintf(buffer+k, size-k, " is required");
+            return l + k;
+        }
+        if (!(d.kind & ERR_OUT_OF_RANGE) || arg == nullptr)
+            return l + snprintf(buffer, size, "%s: \"%s\" was rejected", name, text);
+
+        const _constraint& c = arg->constraint;
+        int check = d.detail;
+        const char* what = check == CLI_CHECK_MIN ? "is below the minimum" : check == CLI_CHECK_MAX ? "is above the maximum" : 
+                           check == CLI_CHECK_STEP ? "is not a multiple of the step" : "is not a power of two";
+        const _limit& limit = check == CLI_CHECK_MIN ? c.min : check == CLI_CHECK_MAX ? c.max : c.step;
+        char bound[32] = "";
+        int kind = _dtype_kind(arg->dtype);
+        if (check != CLI_CHECK_POW2){
+            if (kind == 1)
+                snprintf(bound, sizeof(bound), " %lld", limit.integer);
+            else if (kind == 2)
+                snprintf(bound, sizeof(bound), " %llu", limit.uinteger);
+            else
+                snprintf(bound, sizeof(bound), " %g", limit.real);
+        }
+        return l + snprintf(buffer, size, "%s: %s %s%s", name, text, what, bound);
+    }
+
+    //the first problem of the last parse, see describe()
+    int CommandLine::describeError(char* buffer, int size)
+    {
+        return this->describe(0, buffer, size);
+    }
+
+    //the decoded int[], double[] and string[] parameters of the last parse
+    const ListValues& CommandLine::lists()
+    {
+        return this->list_values;
+    }
+
+    const ParseResult& CommandLine::parsed()
+    {
+        return this->result;
+    }
+
+    /**
+    *   Immutable, reference counted copy of the parsed arguments, safe to share across threads
+    *   Frozen from parsed() directly, taking one does not build the Options tree of parsedArgs()
+    */
+    Snapshot CommandLine::snapshot()
+    {
+        if (!this->frozen.valid())
+            this->frozen = _freeze(this->args->root, this->result);
+        return this->frozen;
+    }
+
     /**
     *   Returns a humanreadable printable string that contains information about the datastructure within this command line
     *   
@@ -1018,6 +5216,236 @@ namespace cli
 
    
 
+#ifdef CLI_ENABLE_WATCHER
+    /**************************************************************************************************************************************
+     * HOT RELOAD
+     *
+     * Compiled in with -DCLI_ENABLE_WATCHER (needs <thread>, link with -pthread)
+    */
+#define CLI_WATCH_INOTIFY 1         //reload when the config file is written or replaced (linux only)
+#define CLI_WATCH_SIGHUP 2          //reload on SIGHUP
+
+    int _cli_watch_signal_fd = -1;   //write end of the wake pipe of the watcher owning SIGHUP
+
+    void _cli_watch_on_sighup(int){
+        char c = 'h';
+        if (_cli_watch_signal_fd >= 0)
+            (void)write(_cli_watch_signal_fd, &c, 1);
+    }
+
+    /**
+     * @brief Re-merges the configuration of a CommandLine in the background and publishes immutable snapshots
+     *
+     * Readers enter through a ConfigReader, which costs two atomic counter updates and never blocks or allocates.
+     * The watcher thread swaps the snapshot pointer RCU style: it flips the reader epoch twice and waits for
+     * each of both reader counters to drain once, only then the old snapshot is deleted.
+     * A reload whose merge reports an error is dropped and the previous snapshot stays in place, unknown keys are
+     * no error (see Config::unknown).
+     * The schema, argv and environment layers must not be changed while watching, only the config file is re-read.
+     */
+    struct ConfigWatcher
+    {
+        CommandLine*                            cli;
+        std::atomic<Config*>                    current;
+        std::atomic<unsigned int>               epoch;
+        std::atomic<int>                        readers[2];
+        std::atomic<int>                        last_error;
+        std::atomic<int>                        reloads;
+
+        std::thread                             worker;
+        int                                     wake[2];        //self pipe, 'h' reloads, 'q' quits
+        int                                     inotify_fd;
+        int                                     modes;
+
+        ConfigWatcher(CommandLine* cli);
+        ~ConfigWatcher();
+        ConfigWatcher(const ConfigWatcher&) = delete;
+        ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+        int start(int modes);
+        void stop();
+        int reload();
+        void publish(Config* next);
+        void run();
+    };
+
+    /**
+     * @brief Pins the current snapshot for as long as it lives
+     *
+     *      cli::ConfigReader cfg(watcher);
+     *      long long port = cfg->integer(port_param);
+     */
+    struct ConfigReader
+    {
+        ConfigWatcher*                          watcher;
+        const Config*                           config;
+        unsigned int                            slot;
+
+        ConfigReader(ConfigWatcher& watcher){
+            this->watcher = &watcher;
+            this->slot = watcher.epoch.load() & 1;
+            watcher.readers[this->slot].fetch_add(1);
+            this->config = watcher.current.load();
+        };
+        ~ConfigReader(){
+            this->watcher->readers[this->slot].fetch_sub(1);
+        };
+        ConfigReader(const ConfigReader&) = delete;
+        ConfigReader& operator=(const ConfigReader&) = delete;
+
+        const Config* operator->() const{
+            return this->config;
+        };
+        const Config& operator*() const{
+            return *this->config;
+        };
+    };
+
+    //merges once synchronously, so readers always find a snapshot
+    ConfigWatcher::ConfigWatcher(CommandLine* cli){
+        this->cli = cli;
+        this->current.store(nullptr);
+        this->epoch.store(0);
+        this->readers[0].store(0);
+        this->readers[1].store(0);
+        this->last_error.store(ERR_NO_ERR);
+        this->reloads.store(0);
+        this->wake[0] = -1;
+        this->wake[1] = -1;
+        this->inotify_fd = -1;
+        this->modes = 0;
+
+        Config* first = new Config();
+        this->last_error.store(this->cli->merge(first));
+        this->current.store(first);
+    };
+
+    ConfigWatcher::~ConfigWatcher(){
+        this->stop();
+        delete this->current.load();
+    };
+
+    int ConfigWatcher::reload(){
+        Config* next = new Config();
+        int err = this->cli->merge(next);
+        this->last_error.store(err);
+        if (err != ERR_NO_ERR){
+            delete next;
+            return err;
+        }
+        this->publish(next);
+        this->reloads.fetch_add(1);
+        return err;
+    };
+
+    void ConfigWatcher::publish(Config* next){
+        Config* old = this->current.exchange(next);
+        //every reader still holding old entered before the exchange, so each counter reaching zero once afterwards
+        //is enough. Flipping the epoch first moves new readers to the other counter, so the drained one stays drained.
+        for (int round=0;round<2;round++){
+            unsigned int drained = this->epoch.fetch_xor(1) & 1;
+            while (this->readers[drained].load() != 0)
+                std::this_thread::yield();
+        }
+        delete old;
+    };
+
+    int ConfigWatcher::start(int modes){
+        if (this->worker.joinable())
+            return ERR_INVALID_INPUT;
+        if (pipe(this->wake) != 0)
+            return ERR_INVALID_INPUT;
+        fcntl(this->wake[1], F_SETFL, O_NONBLOCK);
+        this->modes = modes;
+
+#ifdef __linux__
+        const char* path = this->cli->getConfigFile();
+        if (modes&CLI_WATCH_INOTIFY && path != nullptr){
+            //watch the directory, editors replace the file instead of writing it in place
+            std::string dir(path);
+            size_t slash = dir.rfind('/');
+            dir = slash == std::string::npos ? std::string(".") : dir.substr(0, slash+1);
+            this->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (this->inotify_fd >= 0 && inotify_add_watch(this->inotify_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0){
+                close(this->inotify_fd);
+                this->inotify_fd = -1;
+            }
+        }
+#endif
+        if (modes&CLI_WATCH_SIGHUP){
+            _cli_watch_signal_fd = this->wake[1];
+            struct sigaction sa;
+            sa.sa_handler = _cli_watch_on_sighup;
+            sigemptyset(&sa.sa_mask);
+            sa.sa_flags = SA_RESTART;
+            sigaction(SIGHUP, &sa, nullptr);
+        }
+        this->worker = std::thread(&ConfigWatcher::run, this);
+        return ERR_NO_ERR;
+    };
+
+    void ConfigWatcher::stop(){
+        if (!this->worker.joinable())
+            return;
+        if (this->modes&CLI_WATCH_SIGHUP){
+            signal(SIGHUP, SIG_DFL);
+            _cli_watch_signal_fd = -1;
+        }
+        char c = 'q';
+        (void)write(this->wake[1], &c, 1);
+        this->worker.join();
+        close(this->wake[0]);
+        close(this->wake[1]);
+        if (this->inotify_fd >= 0)
+            close(this->inotify_fd);
+        this->inotify_fd = -1;
+    };
+
+    void ConfigWatcher::run(){
+        const char* path = this->cli->getConfigFile();
+        const char* name = path;
+        for (const char* p = path;p != nullptr && *p != '\0';p++)
+            if (*p == '/')
+                name = p+1;
+
+        struct pollfd fds[2];
+        fds[0].fd = this->wake[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = this->inotify_fd;
+        fds[1].events = POLLIN;
+        int nfds = this->inotify_fd >= 0 ? 2 : 1;
+
+        for (;;){
+            if (poll(fds, nfds, -1) < 0)
+                continue;
+            int changed = 0;
+            if (fds[0].revents&POLLIN){
+                char buf[64];
+                int n = read(this->wake[0], buf, sizeof(buf));
+                for (int i=0;i<n;i++){
+                    if (buf[i] == 'q')
+                        return;
+                    changed |= buf[i] == 'h';
+                }
+            }
+#ifdef __linux__
+            if (nfds > 1 && fds[1].revents&POLLIN){
+                char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+                int n;
+                while ((n = read(this->inotify_fd, buf, sizeof(buf))) > 0)
+                    for (char* p = buf;p < buf+n;p += sizeof(struct inotify_event) + ((struct inotify_event*)p)->len){
+                        struct inotify_event* ev = (struct inotify_event*)p;
+                        if (ev->len > 0 && _compare_cstring(name, ev->name))
+                            changed = 1;
+                    }
+            }
+#endif
+            if (changed)
+                this->reload();
+        }
+    };
+#endif
+
     /**************************************************************************************************************************************
      * ARGUMENT IMPLEMENTATIONS
      * 
@@ -1031,6 +5459,8 @@ namespace cli
         this->arg_type = _NULL_ARG_;
         this->long_flag = "null";
         this->short_flag = "n";
+        this->help_msg = nullptr;
+        this->help_ref = -1;
 
         this-> dtype = CLI_DTYPE_UNDEF;
         this-> dtype_custom = "";
@@ -1052,6 +5482,17 @@ namespace cli
             return NO_ERROR;
         };
         this->parent = nullptr;
+        this->binding = _binding{nullptr, {nullptr, nullptr}, nullptr, nullptr};
+        this->env_name = nullptr;
+        this->env_value = nullptr;
+        this->id = -1;
+        this->default_value = nullptr;
+        this->repeat = CLI_REPEAT_APPEND;
+        this->separator = ',';
+        this->constraint = _constraint();
+        this->choices = nullptr;
+        this->choice_count = 0;
+        this->choice_hash = _choice_hash();
     };
 
     /**
@@ -1073,14 +5514,14 @@ namespace cli
 
         this->arg_type =arg_type;
      
-        this->short_flag = new char[strlen(short_flag)];
-        write_string(this->short_flag, short_flag);
-
-        this->long_flag = new char[strlen(long_flag)];
-        write_string(this->long_flag, long_flag);
-
-        this->help_msg = new char[strlen(help_msg)];
-        write_string(this->help_msg, help_msg);
+        this->short_flag = _intern(short_flag);
+        this->long_flag = _intern(long_flag);
+        this->help_msg = nullptr;
+        if (help_msg != nullptr){
+            this->help_msg = new char[strlen(help_msg)];
+            write_string(this->help_msg, help_msg);
+        }
+        this->help_ref = -1;
 
         this->arg_type      = arg_type;
         this->required      = required;
@@ -1107,6 +5548,17 @@ namespace cli
         };
 
         this->parent = nullptr;
+        this->binding = _binding{nullptr, {nullptr, nullptr}, nullptr, nullptr};
+        this->env_name = nullptr;
+        this->env_value = nullptr;
+        this->id = -1;
+        this->default_value = nullptr;
+        this->repeat = CLI_REPEAT_APPEND;
+        this->separator = ',';
+        this->constraint = _constraint();
+        this->choices = nullptr;
+        this->choice_count = 0;
+        this->choice_hash = _choice_hash();
 
                 
 
@@ -1119,222 +5571,6 @@ namespace cli
 
 
 
-    int attachOptions(Argument* arg, Options* options,  int i,  char** argv, int argc){
-   
-  
-  
-        Options* nop = new Options();
-        nop->setParsed(true);
-        nop->setData(argv[i]);
-        nop->setArgType(arg->arg_type);
-        nop->setKey(arg->long_flag);
-
-        options->setArgc(options->getArgc()+1);
-        options->addOptions(nop);
-        
-    }   
-
-
-
-    /*
-    int Argument::parse(int argc, char** argv, Options* options){
-        
-        int e = 0;
-        int err_glob= 1;
-        if (this->required && argc<2)
-            e |= ERR_REQ_ARG_NOT_FOUND;
-        err_glob |= e;
-       
-
-
-        if (argc < 2){
-            return err_glob;
-        }
-        
-
-        for (int i=1;i<argc;i++){
-            e = 0;
-
-            //parse the current argument
-            e |= parseArg(this, argv[i]);
-
-            err_glob =e;
-            if (e  != ERR_NO_ERR){
-                continue;
-            }
-
-            if(i< argc-1 && e&ERR_NO_ERR){
-
-                attachOptions(this, options, i, argv, argc);
-                if (this->arguments.size()==0){
-                    return err_glob;
-                }
-                char** newargv= copySubArgv(argc, argv, i);
-                if (e & ERR_NO_ERR == ERR_NO_ERR){
-                   
-                    //match found, check if parameters are there
-                    //are there still arguments left in the tree =?
-                    
-                    for (int q=0;q<this->arguments.size();q++){
-                        e |= this->arguments[q]->parse(argc-i, newargv, options->get(this->long_flag)); //adds itself to the tree of argument
-                        if (e& ERR_REQ_ARG_NOT_FOUND && !this->required && this->arguments[q]->required){
-                            e = e & ~ERR_REQ_ARG_NOT_FOUND;
-                        }
-                    }
-
-
-                    if (e == ERR_NO_ERR){
-                        for (int q=0;q<this->arguments.size();q++){
-                            //int k= this->arguments[q]->parse(argc-1, newargv, options->get(this->long_flag)); //adds itself to the tree of arguments
-
-                        }
-                        return e;
-                    }else{
-                    }
-                    err_glob |= e;
-                    }
-                else{
-                   
-                    // if (this->arguments.size()){
-                    //     for (int q=0;q<this->arguments.size();q++){
-                    //         //e |=this->arguments[q]->parse(0,argv, options->get(this->long_flag));
-                    //     }
-                    // }
-                    
-                }   
-                 err_glob |= e;
-
-
-                //the parser jumped recursively into the argument tree
-                if (err_glob & ERR_NO_ERR){
-                    //Argument a = this->
-                }
-                for (int q=0;q<argc-1;q++)
-                    free(newargv[q]);
-                free(newargv);
-            }
-            else{
-                attachOptions(this, options, argc-1, argv, argc);
-                return err_glob;
-            }
-        }
-
-        if (argc == 2){
-            return err_glob;
-        }
-
-        err_glob |= e;
-
-        return err_glob;
-    }*/
-
-    int Argument::parse(int argc, char** argv, Options* options){
-       
-        int e = 0;
-        int err_glob= 1;
-
-
-        if (this->required && argc<2)
-            e |= (this->required ? ERR_REQ_ARG_NOT_FOUND : ERR_NO_ERR);
-        err_glob |= e;
-
-
-
-        if (argc < 2){
-            return err_glob;
-        }
-        
-
-        for (int i=1;i<argc;i++){
-            e = 0;
-           
-            //parse the current argument
-            e |= parseArg(this, argv[i]);
-           
-            err_glob =e;
-           
-            if (e  != ERR_NO_ERR){
-                continue;
-            }
-
-            if(i< argc-1 && e&ERR_NO_ERR){
-
-                attachOptions(this, options, i, argv, argc);
-                if (this->arguments.size()==0){
-                    return err_glob;
-                }
-                char** newargv= copySubArgv(argc, argv, i);
-                if (e & ERR_NO_ERR == ERR_NO_ERR){
-                   
-                    //match found, check if parameters are there
-                    //are there still arguments left in the tree =?
-                    
-                    for (int q=0;q<this->arguments.size();q++){
-                        e |= this->arguments[q]->parse(argc-i, newargv, options->get(this->long_flag)); //adds itself to the tree of argument
-
-
-
-                        if  ( e& ERR_REQ_ARG_NOT_FOUND && (!this->required && this->arguments[q]->required)){
-                            e = e & ~ERR_REQ_ARG_NOT_FOUND;
-                        }
-                    }
-
-
-                    if (e == ERR_NO_ERR){
-                        for (int q=0;q<this->arguments.size();q++){
-                            //int k= this->arguments[q]->parse(argc-1, newargv, options->get(this->long_flag)); //adds itself to the tree of arguments
-
-                        }
-                        return e;
-                    }else{
-                    }
-                        err_glob |= e;
-                        return err_glob;
-                    }
-                else{
-                   
-                    // if (this->arguments.size()){
-                    //     for (int q=0;q<this->arguments.size();q++){
-                    //         //e |=this->arguments[q]->parse(0,argv, options->get(this->long_flag));
-                    //     }
-                    // }
-                    
-                }   
-                 err_glob |= e;
-
-
-                //the parser jumped recursively into the argument tree
-                if (err_glob & ERR_NO_ERR){
-                    //Argument a = this->
-                }
-                for (int q=0;q<argc-1;q++)
-                    free(newargv[q]);
-                free(newargv);
-            }
-            else{
-                 
-                attachOptions(this, options, argc-1, argv, argc);
-                for (int g=0;g<this->arguments.size()>0;g++)
-                    if (this->arguments[g]->required)
-                        err_glob |=(this->arguments[g]->arg_type & PARAM? (this->required && this->arg_type&(OPTION | WILDCARD | METHOD)? ERR_REQ_PARAM_NOT_FOUND : ERR_NO_ERR) : ERR_REQ_ARG_NOT_FOUND);
-                return err_glob;
-            }
-        }
-
-        for (int g=0;g<this->arguments.size()>0;g++)
-            if (this->arguments[g]->required)
-                err_glob |=(this->arguments[g]->arg_type & PARAM? (this->required && this->arg_type&(OPTION | WILDCARD | METHOD)? ERR_REQ_PARAM_NOT_FOUND : ERR_NO_ERR) : ERR_REQ_ARG_NOT_FOUND);
-
-        if (argc == 2){
-            return err_glob;
-        }
-        err_glob |= e;
-
-
-        return err_glob;
-    }
-
-
     Argument *Argument::setCallback(int (*func)())
     {   
         if (CommandLineVerbosity>=VERBOSE_FULL)
@@ -1373,6 +5609,7 @@ namespace cli
 
     Argument * Argument::setRequired(bool rqrd){
         this->required = rqrd;
+        _schema_stamp()++;
 
         return this;
     };
@@ -1396,11 +5633,92 @@ namespace cli
         if (CommandLineVerbosity>=VERBOSE_FULL){
             std::cout << _get_verbosity_msg(6);
         } 
+        arg->parent = this;
         this->arguments.push_back(arg);
        
         return this;
     };
 
+    //the environment variable read when this flag is not given on the commandline
+    Argument* Argument::setEnv(char* name){
+        this->env_name = new char[strlen(name)];
+        write_string(this->env_name, name);
+        return this;
+    };
+
+    /**
+     * @brief How repeated occurrences are kept, one of CLI_REPEAT_*
+     *
+     *      cli::NewArgument(cli::OPTION, "I", "include", false, "Include path")
+     *          ->setRepeat(CLI_REPEAT_APPEND)->addArgument(cli::NewParamter("path", "string"));
+     *
+     * Appended values of one argument are stored next to each other, ParseResult::values(param) walks all of them.
+     */
+    Argument* Argument::setRepeat(int policy){
+        this->repeat = policy;
+        _schema_stamp()++;
+        return this;
+    };
+
+    //the character between the elements of a list dtype, ',' by default
+    Argument* Argument::setSeparator(char separator){
+        this->separator = separator;
+        return this;
+    };
+
+    Argument* Argument::_setLimit(int check, _limit limit){
+        if (check == CLI_CHECK_MIN)
+            this->constraint.min = limit;
+        if (check == CLI_CHECK_MAX)
+            this->constraint.max = limit;
+        if (check == CLI_CHECK_STEP)
+            this->constraint.step = limit;
+        this->constraint.checks |= check;
+        return this;
+    };
+
+    /**
+     * @brief The only values this parameter accepts, the parser keeps the index of the given one
+     *
+     *      cli::NewParamter("mode", "string")->addChoices({"fast", "safe", "off"});
+     *      switch (myCommandLine.parsed().choice(mode)){ case 0: ... }
+     */
+    Argument* Argument::addChoices(const std::initializer_list<char *> &list){
+        char** choices = new char*[this->choice_count + list.size()];
+        for (int i=0;i<this->choice_count;i++)
+            choices[i] = this->choices[i];
+        for (char* choice : list)
+            choices[this->choice_count++] = _intern(choice);
+        delete[] this->choices;
+        this->choices = choices;
+        _schema_stamp()++;
+        return this;
+    };
+
+    //this argument and the one with long_flag must not be given together (resolved when the schema is finalized)
+    Argument* Argument::addExclude(char* long_flag){
+        char** excludes = new char*[this->exclude_count+1];
+        for (int i=0;i<this->exclude_count;i++)
+            excludes[i] = this->excludes[i];
+        excludes[this->exclude_count++] = _intern(long_flag);
+        delete[] this->excludes;
+        this->excludes = excludes;
+        _schema_stamp()++;
+        return this;
+    };
+
+    Argument* Argument::setPowerOfTwo(){
+        this->constraint.checks |= CLI_CHECK_POW2;
+        return this;
+    };
+
+    //the value CommandLine::merge() falls back to when no other layer provides one
+    Argument* Argument::setDefault(char* value){
+        this->default_value = new char[strlen(value)];
+        write_string(this->default_value, value);
+        return this;
+    };
+
     
   
 
@@ -1424,7 +5742,7 @@ namespace cli
             r = combineString(r, combineString(" | dtype: ", this->dtype_custom));
         }
         r = combineString(r, ">\n");
-        for (int i=0;i < this->arguments.size();i++){
+        for (int i=0;i < (int)this->arguments.size();i++){
             r = combineString(r,this->arguments[i]->string(combineString("   ", spacer)));
         }
         return r;
@@ -1482,8 +5800,8 @@ namespace cli
             title,
             false,
             "");
-        arg->dtype_custom = new char[strlen(dtype)];
-        write_string(arg->dtype_custom, dtype);
+        arg->dtype_custom = _intern(dtype);
+        arg->dtype = _dtype_code(dtype);
 
         return arg;
     };